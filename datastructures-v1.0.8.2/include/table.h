@@ -28,12 +28,22 @@
  *
  * Version information:
  *   2018-02-06: v1.0, first public version.
+ *   2026-10-17: v1.1, added table_iter_begin() and table_iter_next().
+ *   2026-10-17: v1.2, added table_insert_many() and table_lookup_many().
  */
 
 // ==========PUBLIC DATA TYPES============
 // Table type.
 typedef struct table table;
 
+// Table iterator type. Declared here so that iterators can be placed on the
+// stack. The fields are only to be used by the table implementation.
+typedef struct table_iter {
+	const table *t;
+	void *pos;
+	int index;
+} table_iter;
+
 // ==========DATA STRUCTURE INTERFACE==========
 
 /**
@@ -85,6 +95,38 @@ void table_insert(table *t, void *key, void *value);
  */
 void *table_lookup(const table *t, const void *key);
 
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Equivalent to calling table_insert() for each pair, in array order.
+ * Implementations may use the knowledge of upcoming keys to speed up the
+ * insertions.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values,
+		       int n);
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Equivalent to storing the result of table_lookup() for each key in the
+ * corresponding position of values. Implementations may use the knowledge
+ * of upcoming keys to speed up the lookups.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values,
+		       int n);
+
 /**
  * table_choose_key() - Return an arbitrary key.
  * @t: Table to inspect.
@@ -135,4 +177,31 @@ void table_kill(table *t);
  */
 void table_print(const table *t, inspect_callback_pair print_func);
 
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Positions the iterator before the first key/value pair of the table. The
+ * pairs are then visited by calling table_iter_next(). The table must not be
+ * modified while an iteration is in progress.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it);
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * Visits the same key/value pairs as table_print(), each pair once, in an
+ * order decided by the table implementation.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value);
+
 #endif
@@ -19,6 +19,9 @@
  *
  * Version information:
  *   2020-05-07: v1.0, first public version.   
+ *   2026-10-17: v1.1, added table_iter_begin() and table_iter_next(), 
+ *                     bugfix in table_print.
+ *   2026-10-17: v1.2, added table_insert_many() and table_lookup_many().
  */
 
 // ==================INTERNAL CONSTANTS=====================
@@ -158,6 +161,40 @@ void *table_lookup(const table *t, const void *key)
 	return NULL;
 }
 
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values,
+		       int n)
+{
+	for (int i = 0; i < n; i++) {
+		table_insert(t, keys[i], values[i]);
+	}
+}
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values,
+		       int n)
+{
+	for (int i = 0; i < n; i++) {
+		values[i] = table_lookup(t, keys[i]);
+	}
+}
+
 /**
  * table_choose_key() - Return an arbitrary key.
  * @t: Table to inspect.
@@ -278,10 +315,52 @@ void table_kill(table *t)
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
-	int i = 0;	
-	while (array_1d_has_value(t->entries, i) && i < TABLE_SIZE) {	
+	// The elements are kept in positions [0, index_last_pos].
+	for (int i = 0; i <= t->index_last_pos; i++) {
 		struct table_entry *e = array_1d_inspect_value(t->entries, i);	
 		print_func(e->key, e->value);
 	}
 }
 
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	// Start at the beginning of the array.
+	it->t = t;
+	it->pos = NULL;
+	it->index = 0;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	// The elements are kept in positions [0, index_last_pos].
+	const table *t = it->t;
+	if (it->index > t->index_last_pos) {
+		return false;
+	}
+	struct table_entry *e = array_1d_inspect_value(t->entries, it->index);
+	if (key != NULL) {
+		*key = e->key;
+	}
+	if (value != NULL) {
+		*value = e->value;
+	}
+	it->index++;
+	return true;
+}
+
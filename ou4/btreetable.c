@@ -0,0 +1,804 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "orderedtable.h"
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. Table constructed as a B+ tree. All key/value pairs are stored
+ * in the leaves, which are linked together in key order. The inner nodes
+ * only hold separator keys that guide the search. Each node stores up to
+ * MAX_KEYS keys in a contiguous array, so a lookup touches only a handful
+ * of nodes and searches each of them with a binary search.
+ *
+ * Every separator key in an inner node is a pointer to the smallest key of
+ * the subtree to its right, i.e. to a key stored in a leaf. Whenever a key
+ * that may be used as separator leaves the tree, the separator is updated
+ * before the key is freed.
+ *
+ * Duplicates are handled at element insertion. The iteration functions
+ * visit the pairs in key order.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Based on earlier code by: Niclas Borlin (niclas@cs.umu.se),
+ *	   	 	     Adam Dahlgren Lindstrom (dali@cs.umu.se),
+ * 			     Johan Eliasson (johane@cs.umu.se).
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ==================INTERNAL CONSTANTS=====================
+
+// Maximum number of keys in a node.
+#define MAX_KEYS 32
+
+// Minimum number of keys in a node, except the root.
+#define MIN_KEYS (MAX_KEYS / 2)
+
+// ==================INTERNAL DATA TYPES====================
+
+// Common head of leaves and inner nodes. The key arrays have room for one
+// extra key, so a node may overflow before it is split.
+struct node {
+	int nr_of_keys;
+	bool is_leaf;
+	void *keys[MAX_KEYS + 1];
+};
+
+struct leaf {
+	struct node node;
+	void *values[MAX_KEYS + 1];
+	struct leaf *next;
+};
+
+struct inner {
+	struct node node;
+	struct node *children[MAX_KEYS + 2];
+};
+
+struct table {
+	struct node *root;
+	struct leaf *first;
+	compare_function *key_cmp_func;
+	free_function key_free_func;
+	free_function value_free_func;
+	int nr_of_elements;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * leaf_new() - Allocate an empty leaf.
+ *
+ * Returns: Pointer to the new leaf.
+ */
+static struct leaf *leaf_new(void)
+{
+	struct leaf *l = malloc(sizeof(*l));
+	l->node.nr_of_keys = 0;
+	l->node.is_leaf = true;
+	l->next = NULL;
+	return l;
+}
+
+/**
+ * inner_new() - Allocate an empty inner node.
+ *
+ * Returns: Pointer to the new inner node.
+ */
+static struct inner *inner_new(void)
+{
+	struct inner *in = malloc(sizeof(*in));
+	in->node.nr_of_keys = 0;
+	in->node.is_leaf = false;
+	return in;
+}
+
+/**
+ * lower_bound() - Binary search for a key in a node.
+ * @t: Table holding the compare function.
+ * @n: Node to search.
+ * @key: Key to search for.
+ *
+ * Returns: Index of the first key in the node not less than the given key.
+ */
+static int lower_bound(const table *t, const struct node *n, const void *key)
+{
+	int lo = 0;
+	int hi = n->nr_of_keys;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (t->key_cmp_func(n->keys[mid], key) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * upper_bound() - Binary search for a key in a node.
+ * @t: Table holding the compare function.
+ * @n: Node to search.
+ * @key: Key to search for.
+ *
+ * In an inner node, the returned index is the index of the child to descend
+ * into when looking for the key.
+ *
+ * Returns: Index of the first key in the node greater than the given key.
+ */
+static int upper_bound(const table *t, const struct node *n, const void *key)
+{
+	int lo = 0;
+	int hi = n->nr_of_keys;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (t->key_cmp_func(n->keys[mid], key) <= 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * find_leaf() - Find the leaf where a key belongs.
+ * @t: Table to inspect.
+ * @key: Key to look for.
+ *
+ * Returns: The leaf that holds the key, if the key is in the table.
+ */
+static struct leaf *find_leaf(const table *t, const void *key)
+{
+	struct node *n = t->root;
+	while (!n->is_leaf) {
+		n = ((struct inner *)n)->children[upper_bound(t, n, key)];
+	}
+	return (struct leaf *)n;
+}
+
+/**
+ * smallest_key() - Return the smallest key in a subtree.
+ * @n: Root of the subtree.
+ *
+ * Returns: The first key of the leftmost leaf in the subtree.
+ */
+static void *smallest_key(const struct node *n)
+{
+	while (!n->is_leaf) {
+		n = ((const struct inner *)n)->children[0];
+	}
+	return n->keys[0];
+}
+
+/**
+ * fix_separator() - Update the separator that points to an old key.
+ * @t: Table to manipulate.
+ * @key: Key equal to the old key, used to find the separator.
+ * @old_key: Pointer to a key that is no longer stored in a leaf.
+ *
+ * If the old key is used as separator, it is replaced by the smallest key
+ * of the subtree to the right of the separator. The separator can only be
+ * found on the search path of the key.
+ *
+ * Returns: Nothing.
+ */
+static void fix_separator(table *t, const void *key, const void *old_key)
+{
+	struct node *n = t->root;
+	while (!n->is_leaf) {
+		int c = upper_bound(t, n, key);
+		struct inner *in = (struct inner *)n;
+		if (c > 0 && n->keys[c - 1] == old_key) {
+			n->keys[c - 1] = smallest_key(in->children[c]);
+			return;
+		}
+		n = in->children[c];
+	}
+}
+
+/**
+ * insert_rec() - Insert a new key/value pair into a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of the subtree.
+ * @key: A pointer to the key value. The key must not be in the table.
+ * @value: A pointer to the value value.
+ * @separator: Pointer to where the separator key for a split is stored.
+ *
+ * If the root of the subtree overflows it is split in two halves. The new
+ * right half is returned and the key separating the halves is stored in
+ * separator.
+ *
+ * Returns: The new right sibling of n, or NULL if n was not split.
+ */
+static struct node *insert_rec(table *t, struct node *n, void *key,
+			       void *value, void **separator)
+{
+	if (n->is_leaf) {
+		struct leaf *l = (struct leaf *)n;
+		int i = lower_bound(t, n, key);
+		int tail = n->nr_of_keys - i;
+		memmove(&n->keys[i + 1], &n->keys[i], tail * sizeof(void *));
+		memmove(&l->values[i + 1], &l->values[i], tail * sizeof(void *));
+		n->keys[i] = key;
+		l->values[i] = value;
+		n->nr_of_keys++;
+		if (n->nr_of_keys <= MAX_KEYS) {
+			return NULL;
+		}
+		// Move the upper half to a new leaf.
+		struct leaf *right = leaf_new();
+		int mid = n->nr_of_keys / 2;
+		right->node.nr_of_keys = n->nr_of_keys - mid;
+		memcpy(right->node.keys, &n->keys[mid],
+		       right->node.nr_of_keys * sizeof(void *));
+		memcpy(right->values, &l->values[mid],
+		       right->node.nr_of_keys * sizeof(void *));
+		n->nr_of_keys = mid;
+		right->next = l->next;
+		l->next = right;
+		*separator = right->node.keys[0];
+		return &right->node;
+	}
+
+	struct inner *in = (struct inner *)n;
+	int c = upper_bound(t, n, key);
+	void *child_separator;
+	struct node *child_right = insert_rec(t, in->children[c], key, value,
+					      &child_separator);
+	if (child_right == NULL) {
+		return NULL;
+	}
+	// Insert the new child to the right of the one that was split.
+	int tail = n->nr_of_keys - c;
+	memmove(&n->keys[c + 1], &n->keys[c], tail * sizeof(void *));
+	memmove(&in->children[c + 2], &in->children[c + 1],
+		tail * sizeof(struct node *));
+	n->keys[c] = child_separator;
+	in->children[c + 1] = child_right;
+	n->nr_of_keys++;
+	if (n->nr_of_keys <= MAX_KEYS) {
+		return NULL;
+	}
+	// Move the upper half to a new inner node. The middle key moves up.
+	struct inner *right = inner_new();
+	int mid = n->nr_of_keys / 2;
+	right->node.nr_of_keys = n->nr_of_keys - mid - 1;
+	memcpy(right->node.keys, &n->keys[mid + 1],
+	       right->node.nr_of_keys * sizeof(void *));
+	memcpy(right->children, &in->children[mid + 1],
+	       (right->node.nr_of_keys + 1) * sizeof(struct node *));
+	n->nr_of_keys = mid;
+	*separator = n->keys[mid];
+	return &right->node;
+}
+
+/**
+ * borrow_from_left() - Move one key from the left sibling of a child.
+ * @p: Parent of the child.
+ * @c: Index of the child in the parent.
+ *
+ * Returns: Nothing.
+ */
+static void borrow_from_left(struct inner *p, int c)
+{
+	struct node *n = p->children[c];
+	struct node *left = p->children[c - 1];
+	memmove(&n->keys[1], &n->keys[0], n->nr_of_keys * sizeof(void *));
+	if (n->is_leaf) {
+		struct leaf *l = (struct leaf *)n;
+		struct leaf *ll = (struct leaf *)left;
+		memmove(&l->values[1], &l->values[0],
+			n->nr_of_keys * sizeof(void *));
+		n->keys[0] = left->keys[left->nr_of_keys - 1];
+		l->values[0] = ll->values[left->nr_of_keys - 1];
+		p->node.keys[c - 1] = n->keys[0];
+	} else {
+		struct inner *in = (struct inner *)n;
+		struct inner *lin = (struct inner *)left;
+		memmove(&in->children[1], &in->children[0],
+			(n->nr_of_keys + 1) * sizeof(struct node *));
+		n->keys[0] = p->node.keys[c - 1];
+		in->children[0] = lin->children[left->nr_of_keys];
+		p->node.keys[c - 1] = left->keys[left->nr_of_keys - 1];
+	}
+	n->nr_of_keys++;
+	left->nr_of_keys--;
+}
+
+/**
+ * borrow_from_right() - Move one key from the right sibling of a child.
+ * @p: Parent of the child.
+ * @c: Index of the child in the parent.
+ *
+ * Returns: Nothing.
+ */
+static void borrow_from_right(struct inner *p, int c)
+{
+	struct node *n = p->children[c];
+	struct node *right = p->children[c + 1];
+	if (n->is_leaf) {
+		struct leaf *l = (struct leaf *)n;
+		struct leaf *rl = (struct leaf *)right;
+		n->keys[n->nr_of_keys] = right->keys[0];
+		l->values[n->nr_of_keys] = rl->values[0];
+		memmove(&right->keys[0], &right->keys[1],
+			(right->nr_of_keys - 1) * sizeof(void *));
+		memmove(&rl->values[0], &rl->values[1],
+			(right->nr_of_keys - 1) * sizeof(void *));
+		p->node.keys[c] = right->keys[0];
+	} else {
+		struct inner *in = (struct inner *)n;
+		struct inner *rin = (struct inner *)right;
+		n->keys[n->nr_of_keys] = p->node.keys[c];
+		in->children[n->nr_of_keys + 1] = rin->children[0];
+		p->node.keys[c] = right->keys[0];
+		memmove(&right->keys[0], &right->keys[1],
+			(right->nr_of_keys - 1) * sizeof(void *));
+		memmove(&rin->children[0], &rin->children[1],
+			right->nr_of_keys * sizeof(struct node *));
+	}
+	n->nr_of_keys++;
+	right->nr_of_keys--;
+}
+
+/**
+ * merge_children() - Merge two neighbouring children of a node.
+ * @p: Parent of the children.
+ * @c: Index of the left child. The right child has index c + 1.
+ *
+ * All keys of the right child are moved to the left child, and the right
+ * child is deallocated.
+ *
+ * Returns: Nothing.
+ */
+static void merge_children(struct inner *p, int c)
+{
+	struct node *left = p->children[c];
+	struct node *right = p->children[c + 1];
+	if (left->is_leaf) {
+		struct leaf *ll = (struct leaf *)left;
+		struct leaf *rl = (struct leaf *)right;
+		memcpy(&left->keys[left->nr_of_keys], right->keys,
+		       right->nr_of_keys * sizeof(void *));
+		memcpy(&ll->values[left->nr_of_keys], rl->values,
+		       right->nr_of_keys * sizeof(void *));
+		left->nr_of_keys += right->nr_of_keys;
+		ll->next = rl->next;
+	} else {
+		struct inner *lin = (struct inner *)left;
+		struct inner *rin = (struct inner *)right;
+		// The separator moves down between the two halves.
+		left->keys[left->nr_of_keys] = p->node.keys[c];
+		memcpy(&left->keys[left->nr_of_keys + 1], right->keys,
+		       right->nr_of_keys * sizeof(void *));
+		memcpy(&lin->children[left->nr_of_keys + 1], rin->children,
+		       (right->nr_of_keys + 1) * sizeof(struct node *));
+		left->nr_of_keys += right->nr_of_keys + 1;
+	}
+	free(right);
+
+	// Remove the separator and the right child from the parent.
+	int tail = p->node.nr_of_keys - c - 1;
+	memmove(&p->node.keys[c], &p->node.keys[c + 1], tail * sizeof(void *));
+	memmove(&p->children[c + 1], &p->children[c + 2],
+		tail * sizeof(struct node *));
+	p->node.nr_of_keys--;
+}
+
+/**
+ * remove_rec() - Remove a key from a subtree.
+ * @t: Table to manipulate.
+ * @n: Root of the subtree.
+ * @key: Key to remove.
+ * @removed_key: Pointer to where the removed key is stored.
+ * @removed_value: Pointer to where the removed value is stored.
+ *
+ * Children that underflow are refilled from a sibling, or merged with it.
+ * The root of the subtree itself may be left with too few keys.
+ *
+ * Returns: True if the key was found and removed, false otherwise.
+ */
+static bool remove_rec(table *t, struct node *n, const void *key,
+		       void **removed_key, void **removed_value)
+{
+	if (n->is_leaf) {
+		struct leaf *l = (struct leaf *)n;
+		int i = lower_bound(t, n, key);
+		if (i == n->nr_of_keys || t->key_cmp_func(n->keys[i], key) != 0) {
+			return false;
+		}
+		*removed_key = n->keys[i];
+		*removed_value = l->values[i];
+		int tail = n->nr_of_keys - i - 1;
+		memmove(&n->keys[i], &n->keys[i + 1], tail * sizeof(void *));
+		memmove(&l->values[i], &l->values[i + 1], tail * sizeof(void *));
+		n->nr_of_keys--;
+		return true;
+	}
+
+	struct inner *in = (struct inner *)n;
+	int c = upper_bound(t, n, key);
+	if (!remove_rec(t, in->children[c], key, removed_key, removed_value)) {
+		return false;
+	}
+	if (in->children[c]->nr_of_keys >= MIN_KEYS) {
+		return true;
+	}
+	// Refill the child from a sibling with spare keys, or merge the two.
+	if (c > 0 && in->children[c - 1]->nr_of_keys > MIN_KEYS) {
+		borrow_from_left(in, c);
+	} else if (c < n->nr_of_keys
+		   && in->children[c + 1]->nr_of_keys > MIN_KEYS) {
+		borrow_from_right(in, c);
+	} else if (c > 0) {
+		merge_children(in, c - 1);
+	} else {
+		merge_children(in, c);
+	}
+	return true;
+}
+
+/**
+ * kill_rec() - Deallocate a subtree.
+ * @t: Table holding the free functions.
+ * @n: Root of the subtree.
+ *
+ * Returns: Nothing.
+ */
+static void kill_rec(table *t, struct node *n)
+{
+	if (n->is_leaf) {
+		struct leaf *l = (struct leaf *)n;
+		for (int i = 0; i < n->nr_of_keys; i++) {
+			if (t->key_free_func != NULL) {
+				t->key_free_func(n->keys[i]);
+			}
+			if (t->value_free_func != NULL) {
+				t->value_free_func(l->values[i]);
+			}
+		}
+	} else {
+		struct inner *in = (struct inner *)n;
+		for (int i = 0; i <= n->nr_of_keys; i++) {
+			kill_rec(t, in->children[i]);
+		}
+	}
+	free(n);
+}
+
+// ===========PUBLIC FUNCTION IMPLEMENTATIONS============
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	// Allocate the table header.
+	table *t = calloc(1, sizeof(table));
+	// The tree starts out as a single empty leaf. This leaf stays the
+	// leftmost leaf for the lifetime of the table.
+	t->first = leaf_new();
+	t->root = &t->first->node;
+	// Store the key compare function and key/value free functions.
+	t->key_cmp_func = key_cmp_func;
+	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+	t->nr_of_elements = 0;
+
+	return t;
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->nr_of_elements == 0;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key is already in the
+ * table, the old key/value pair is replaced. Otherwise the pair is inserted
+ * into its leaf, and full nodes are split on the way back up to the root.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	struct leaf *l = find_leaf(t, key);
+	int i = lower_bound(t, &l->node, key);
+	if (i < l->node.nr_of_keys
+	    && t->key_cmp_func(l->node.keys[i], key) == 0) {
+		// If we have a key match, call free function for the old
+		// key/value pair and replace it.
+		void *old_key = l->node.keys[i];
+		if (t->value_free_func != NULL) {
+			t->value_free_func(l->values[i]);
+		}
+		l->node.keys[i] = key;
+		l->values[i] = value;
+		if (i == 0) {
+			fix_separator(t, key, old_key);
+		}
+		if (t->key_free_func != NULL) {
+			t->key_free_func(old_key);
+		}
+		return;
+	}
+
+	void *separator;
+	struct node *right = insert_rec(t, t->root, key, value, &separator);
+	if (right != NULL) {
+		// The root was split, grow the tree by one level.
+		struct inner *root = inner_new();
+		root->node.nr_of_keys = 1;
+		root->node.keys[0] = separator;
+		root->children[0] = t->root;
+		root->children[1] = right;
+		t->root = &root->node;
+	}
+	t->nr_of_elements++;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	struct leaf *l = find_leaf(t, key);
+	int i = lower_bound(t, &l->node, key);
+	if (i < l->node.nr_of_keys
+	    && t->key_cmp_func(l->node.keys[i], key) == 0) {
+		return l->values[i];
+	}
+	// No match found, return NULL.
+	return NULL;
+}
+
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Equivalent to calling table_insert() for each pair in order.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values,
+		       int n)
+{
+	for (int i = 0; i < n; i++) {
+		table_insert(t, keys[i], values[i]);
+	}
+}
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values,
+		       int n)
+{
+	for (int i = 0; i < n; i++) {
+		values[i] = table_lookup(t, keys[i]);
+	}
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return the smallest key in the table. Can be used together with
+ * table_remove() to deconstruct the table. Undefined for an empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+	return t->first->node.keys[0];
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Leaves and inner nodes left with too few keys are refilled from, or
+ * merged with, a sibling. If the root is left without keys, the tree
+ * shrinks by one level. Will call any free functions set for keys/values.
+ * Does nothing if key is not found in the table.
+ *
+ * Returns: Nothing.
+ */
+void table_remove(table *t, const void *key)
+{
+	void *removed_key;
+	void *removed_value;
+	if (!remove_rec(t, t->root, key, &removed_key, &removed_value)) {
+		return;
+	}
+	if (!t->root->is_leaf && t->root->nr_of_keys == 0) {
+		struct node *old_root = t->root;
+		t->root = ((struct inner *)old_root)->children[0];
+		free(old_root);
+	}
+	t->nr_of_elements--;
+
+	// The removed key may still be used as separator. Key may point to
+	// the same memory as the removed key, so free it only afterwards.
+	fix_separator(t, key, removed_key);
+	if (t->key_free_func != NULL) {
+		t->key_free_func(removed_key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(removed_value);
+	}
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	kill_rec(t, t->root);
+	free(t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table in key order and prints
+ * them.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	for (struct leaf *l = t->first; l != NULL; l = l->next) {
+		for (int i = 0; i < l->node.nr_of_keys; i++) {
+			print_func(l->node.keys[i], l->values[i]);
+		}
+	}
+}
+
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	// Start at the smallest key.
+	it->t = t;
+	it->pos = t->first;
+	it->index = 0;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * The pairs are visited in key order by following the links between the
+ * leaves.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	struct leaf *l = it->pos;
+	while (l != NULL && it->index >= l->node.nr_of_keys) {
+		l = l->next;
+		it->index = 0;
+	}
+	it->pos = l;
+	if (l == NULL) {
+		return false;
+	}
+	if (key != NULL) {
+		*key = l->node.keys[it->index];
+	}
+	if (value != NULL) {
+		*value = l->values[it->index];
+	}
+	it->index++;
+	return true;
+}
+
+/**
+ * table_iter_seek() - Start an ordered iteration at a given key.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ * @key: Key to start at.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_seek(const table *t, table_iter *it, const void *key)
+{
+	struct leaf *l = find_leaf(t, key);
+	it->t = t;
+	it->pos = l;
+	it->index = lower_bound(t, &l->node, key);
+}
+
+/**
+ * table_lookup_range() - Visit all key/value pairs in a range of keys.
+ * @t: Table to inspect.
+ * @lo: Smallest key to visit.
+ * @hi: Largest key to visit.
+ * @inspect_func: Function called for each key/value pair in the range.
+ *
+ * Finds the leaf of the smallest key in the range, then follows the links
+ * between the leaves until a key larger than hi is found.
+ *
+ * Returns: The number of visited key/value pairs.
+ */
+int table_lookup_range(const table *t, const void *lo, const void *hi,
+		       inspect_callback_pair inspect_func)
+{
+	int count = 0;
+	struct leaf *l = find_leaf(t, lo);
+	int i = lower_bound(t, &l->node, lo);
+	while (l != NULL) {
+		for (; i < l->node.nr_of_keys; i++) {
+			if (t->key_cmp_func(l->node.keys[i], hi) > 0) {
+				return count;
+			}
+			inspect_func(l->node.keys[i], l->values[i]);
+			count++;
+		}
+		l = l->next;
+		i = 0;
+	}
+	return count;
+}
@@ -51,4 +51,38 @@ do ./hashtabletest -n -t $i >> ${name}_hash.txt;
 done
 done 
 
+# swisstable
+for n in {1..5}; 
+do ./swisstabletest -n -t 1000 >> ${name}_swiss.txt; 
+done
 
+for (( i = 2000; i <= max_index; i = i + 2000 ));
+do
+for n in {1..5};
+do ./swisstabletest -n -t $i >> ${name}_swiss.txt;
+done
+done 
+
+# sortedtable
+for n in {1..5}; 
+do ./sortedtabletest -n -t 1000 >> ${name}_sorted.txt; 
+done
+
+for (( i = 2000; i <= max_index; i = i + 2000 ));
+do
+for n in {1..5};
+do ./sortedtabletest -n -t $i >> ${name}_sorted.txt;
+done
+done 
+
+# btreetable
+for n in {1..5}; 
+do ./btreetabletest -n -t 1000 >> ${name}_btree.txt; 
+done
+
+for (( i = 2000; i <= max_index; i = i + 2000 ));
+do
+for n in {1..5};
+do ./btreetabletest -n -t $i >> ${name}_btree.txt;
+done
+done 
@@ -0,0 +1,116 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "hash.h"
+
+/*
+ * Implementation of the built-in hash functions used by the hash based table
+ * implementations of OU4, see hash.h.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version, moved from hashtable.c.
+ *   2026-10-17: v1.1, added hash_u64().
+ */
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * fmix64() - Mix the bits of a 64-bit value.
+ * @h: Value to mix.
+ *
+ * Finalization step of MurmurHash3. Every input bit affects every output bit,
+ * so the low bits of the result can be used directly as an array index.
+ *
+ * Returns: The mixed value.
+ */
+static uint64_t fmix64(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+/**
+ * rotl64() - Rotate a 64-bit value to the left.
+ * @x: Value to rotate.
+ * @r: Number of bits to rotate, 0 < r < 64.
+ *
+ * Returns: The rotated value.
+ */
+static uint64_t rotl64(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+/**
+ * hash_int() - Hash an integer key.
+ * @key: A pointer to the key value. Only the first 4 bytes of the key are
+ *	 used, i.e. the key has to be of int type or a char array with at
+ *	 least 4 characters.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_int(const void *key)
+{
+	// Copy the bytes, the key is not necessarily aligned as an int.
+	uint32_t k;
+	memcpy(&k, key, sizeof(k));
+	return fmix64(k);
+}
+
+/**
+ * hash_u64() - Hash a 64-bit integer key.
+ * @key: A pointer to the key value, e.g. a uint64_t.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_u64(const void *key)
+{
+	// Copy the bytes, the key is not necessarily aligned.
+	uint64_t k;
+	memcpy(&k, key, sizeof(k));
+	return fmix64(k);
+}
+
+/**
+ * hash_string() - Hash a null-terminated string key.
+ * @key: A pointer to the string.
+ *
+ * The string is consumed 8 bytes at a time in the manner of xxHash64, with 
+ * the remaining 0-7 bytes folded into a last word.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_string(const void *key)
+{
+	const uint64_t prime1 = 0x9e3779b185ebca87ULL;
+	const uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+	const uint64_t prime4 = 0x85ebca77c2b2ae63ULL;
+
+	const unsigned char *p = key;
+	size_t len = strlen(key);
+	uint64_t h = prime4 + len;
+
+	// Full words.
+	while (len >= 8) {
+		uint64_t w;
+		memcpy(&w, p, sizeof(w));
+		h ^= rotl64(w * prime2, 31) * prime1;
+		h = rotl64(h, 27) * prime1 + prime4;
+		p += 8;
+		len -= 8;
+	}
+	// Remaining bytes.
+	if (len > 0) {
+		uint64_t w = 0;
+		memcpy(&w, p, len);
+		h ^= rotl64(w * prime2, 31) * prime1;
+		h = rotl64(h, 27) * prime1 + prime4;
+	}
+	return fmix64(h);
+}
@@ -0,0 +1,50 @@
+#ifndef __HASH_H
+#define __HASH_H
+
+#include <stdint.h>
+
+/*
+ * Hash function type and built-in hash functions for the hash based table 
+ * implementations of OU4.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version, moved from hashtable.h.
+ *   2026-10-17: v1.1, added hash_u64().
+ */
+
+// Type definition for hash function, used by hash based tables.
+//
+// Hash functions should return the same value for all keys that the
+// compare_function of the table considers equal. The returned value does
+// not need to be reduced to any particular range.
+typedef uint64_t hash_function(const void *);
+
+/**
+ * hash_int() - Hash an integer key.
+ * @key: A pointer to the key value. Only the first 4 bytes of the key are
+ *	 used, i.e. the key has to be of int type or a char array with at
+ *	 least 4 characters.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_int(const void *key);
+
+/**
+ * hash_u64() - Hash a 64-bit integer key.
+ * @key: A pointer to the key value, e.g. a uint64_t.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_u64(const void *key);
+
+/**
+ * hash_string() - Hash a null-terminated string key.
+ * @key: A pointer to the string.
+ *
+ * Returns: Hash value of the key.
+ */
+uint64_t hash_string(const void *key);
+
+#endif
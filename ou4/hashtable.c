@@ -4,17 +4,33 @@
 #include <inttypes.h>
 
 #include "table.h"
-#include "array_1d.h"
+#include "hashtable.h"
 
 /*
  * Implementation of a generic hash table for the "Datastructures and
  * algorithms" courses at the Department of Computing Science, Umea
- * University. Table constructed as an one dimensional array where index is 
- * found using a simple hash function. Hash collisions are handled by closed,
- * quadratically incremented searches.
+ * University. Table constructed as an one dimensional array of key/value 
+ * slots where index is found using a hash function, by default hash_int().
+ * Other hash functions can be given to table_empty_hash(), see hashtable.h.
+ * Hash collisions are handled by closed, quadratically incremented searches.
+ *
+ * The array starts small and its size is always a power of two. When the 
+ * load factor, counting both elements and "removed" markers, would exceed 
+ * MAX_LOAD_FACTOR the table is rehashed into a larger array. With a power of
+ * two size, the triangular probe sequence hash + 1 + 2 + ... + i is 
+ * guaranteed to visit every position in the array. 
+ *
+ * Each slot stores the key and value pointers, the lower 32 bits of the hash
+ * of the key and a state byte telling if the slot is empty, full or holds a 
+ * "removed" marker. The stored hash lets probing skip most non-matching keys
+ * without calling the compare function, and lets the table be rehashed 
+ * without hashing the keys again.
  *
  * Duplicates are handled at element insertion. A "removed" marker will be 
- * placed in the array at element removal.
+ * placed in the array at element removal. The markers are counted, and the 
+ * table is rehashed in place once they take up too large a part of the 
+ * array, so a table with a steady stream of inserts and removals does not 
+ * fill up with markers. 
  *
  * Author: Elias Olofsson (tfy17eon@cs.umu.se) 
  *
@@ -24,62 +40,232 @@
  *
  * Version information:
  *   2020-05-07: v1.0, first public version.   
+ *   2026-10-17: v1.1, resizable array, rehash on high load factor.
+ *   2026-10-17: v1.2, pluggable hash function, hash_int() and hash_string().
+ *   2026-10-17: v1.3, key/value pairs stored directly in the array.
+ *   2026-10-17: v1.4, compaction of "removed" markers, shrink on removal.
+ *   2026-10-17: v1.5, constant time table_choose_key(), added 
+ *                     table_iter_begin() and table_iter_next().
+ *   2026-10-17: v1.6, added table_insert_many() and table_lookup_many().
  */
 
 // ==================INTERNAL CONSTANTS=====================
 
-// Size of table to generate
-#define TABLE_SIZE 80021
+// Initial size of the array, must be a power of two.
+#define INITIAL_CAPACITY 16
+
+// Max fraction of the array that may hold elements or "removed" markers.
+#define MAX_LOAD_FACTOR 0.5
+
+// Max fraction of the array that may hold "removed" markers before the table
+// is compacted on removal.
+#define MAX_REMOVED_FACTOR 0.25
+
+// Min fraction of the array that has to hold elements before the table is 
+// shrunk on removal.
+#define MIN_LOAD_FACTOR 0.0625
+
+// Number of keys hashed and prefetched ahead in table_insert_many() and 
+// table_lookup_many().
+#define BATCH_SIZE 16
+
+// States of a slot in the array. SLOT_PENDING is only used while the table
+// is rehashed in place, for elements that have not yet been moved.
+#define SLOT_EMPTY 0
+#define SLOT_FULL 1
+#define SLOT_REMOVED 2
+#define SLOT_PENDING 3
 
 // ==================INTERNAL DATA TYPES====================
 
+struct table_entry {
+	void *key;
+	void *value;
+	uint32_t hash;
+	uint8_t state;
+};
+
 struct table {
-	array_1d *entries;
+	struct table_entry *entries;
 	compare_function *key_cmp_func;
+	hash_function *key_hash_func;
 	free_function key_free_func;
 	free_function value_free_func;
+	int capacity;
 	int nr_of_elements;
-};
-
-struct table_entry {
-	void *key;
-	void *value;
+	int nr_of_removed;
+	int first_full;
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
 /**
- * hash_function() - Hash the given key to an useable array index.
- * @key: A pointer to the key value. Key has to be of int type or char array 
- *	 with at least 4 characters. Only the first 4 bytes of the key will be 
- *	 used in the hashing process.	
- * 
- * Returns: Array index corresponding to the key value.  
+ * rehash_in_place() - Drop all "removed" markers without a new array.
+ * @t: Table to manipulate.
+ *
+ * All elements are first marked as pending and all markers are cleared. 
+ * Each pending element is then moved to the first empty or pending slot of 
+ * its probe sequence. If that slot holds another pending element, the two 
+ * are swapped and the search continues for the displaced element. Every 
+ * step settles one element, and a settled element is never moved again, so
+ * no extra memory is needed. The stored hash values are reused.
+ *
+ * Returns: Nothing.
  */
-unsigned int hash_function(const void *key) 
+static void rehash_in_place(table *t)
 {
-	// Allocate string buffer and length of string.
-	char str[16];
-	int length = 0;
-	
-	// Typecast the key to int, only "keeping" the first 4 bytes of data.
-	const int32_t *int_ptr = key;
-	
-	// Convert int to a string of numbers, save the length of the string.
-	length = sprintf(str, "%d", *int_ptr);
-	
-	// Hash the string.
-	unsigned int hash = 0;
-	int seed = 13131; // Magic number
-	for (int i = 0; i < length; i++) {
-		hash = (hash * seed) + str[i];
+	struct table_entry *entries = t->entries;
+	unsigned int mask = t->capacity - 1;
+
+	for (int j = 0; j < t->capacity; j++) {
+		entries[j].state = entries[j].state == SLOT_FULL ? SLOT_PENDING 
+								 : SLOT_EMPTY;
+	}
+	for (int j = 0; j < t->capacity; j++) {
+		if (entries[j].state != SLOT_PENDING) {
+			continue;
+		}
+		// Take the element out, its slot is free until refilled.
+		struct table_entry moving = entries[j];
+		entries[j].state = SLOT_EMPTY;
+		for (;;) {
+			unsigned int pos = moving.hash & mask;
+			int i = 0;
+			while (entries[pos].state == SLOT_FULL) {
+				i++;
+				pos = (pos + i) & mask;
+			}
+			struct table_entry displaced = entries[pos];
+			entries[pos] = moving;
+			entries[pos].state = SLOT_FULL;
+			if (displaced.state == SLOT_EMPTY) {
+				break;
+			}
+			// Continue with the pending element that was in the way.
+			moving = displaced;
+		}
+	}
+	t->nr_of_removed = 0;
+	t->first_full = t->capacity;
+	for (int j = 0; j < t->capacity; j++) {
+		if (entries[j].state == SLOT_FULL) {
+			t->first_full = j;
+			break;
+		}
 	}
-	return hash % TABLE_SIZE;
 }
 
 /**
- * table_empty() - Create an empty table.
+ * rehash() - Move all elements of the table into an array of a given size.
+ * @t: Table to manipulate.
+ * @capacity: Size of the new array, must be a power of two.
+ *
+ * All "removed" markers are dropped in the process. If the size is 
+ * unchanged the table is compacted with rehash_in_place(), otherwise all 
+ * elements are inserted into a new array and the old array is destroyed. 
+ * The stored hash values are reused, so no key is hashed or compared.
+ *
+ * Returns: Nothing.
+ */
+static void rehash(table *t, int capacity)
+{
+	if (capacity == t->capacity) {
+		rehash_in_place(t);
+		return;
+	}
+
+	struct table_entry *old_entries = t->entries;
+	int old_capacity = t->capacity;
+
+	t->entries = calloc(capacity, sizeof(*t->entries));
+	t->capacity = capacity;
+	t->nr_of_removed = 0;
+	t->first_full = capacity;
+
+	unsigned int mask = capacity - 1;
+	for (int j = 0; j < old_capacity; j++) {
+		// Skip empty slots and "removed" markers.
+		if (old_entries[j].state != SLOT_FULL) {
+			continue;
+		}
+		// Keys are unique, so just find the first empty slot.
+		unsigned int pos = old_entries[j].hash & mask;
+		int i = 0;
+		while (t->entries[pos].state != SLOT_EMPTY) {
+			i++;
+			pos = (pos + i) & mask;
+		}
+		t->entries[pos] = old_entries[j];
+		if ((int)pos < t->first_full) {
+			t->first_full = pos;
+		}
+	}
+	free(old_entries);
+}
+
+/**
+ * capacity_for() - Array size suitable for a given number of elements.
+ * @nr_of_elements: Number of elements the array should hold.
+ *
+ * Returns: The smallest power of two, at least INITIAL_CAPACITY, that keeps 
+ * 	    the elements below half of the allowed load.
+ */
+static int capacity_for(int nr_of_elements)
+{
+	int capacity = INITIAL_CAPACITY;
+	while (2 * nr_of_elements > capacity * MAX_LOAD_FACTOR) {
+		capacity *= 2;
+	}
+	return capacity;
+}
+
+/**
+ * grow_if_needed() - Make room for more elements in the table.
+ * @t: Table to manipulate.
+ * @n: Number of elements to make room for.
+ *
+ * Rehashes the table if n more occupied positions would push the load 
+ * factor above MAX_LOAD_FACTOR. The new size is given by capacity_for(), so 
+ * a table full of "removed" markers may be rehashed without growing.
+ *
+ * Returns: Nothing.
+ */
+static void grow_if_needed(table *t, int n)
+{
+	int occupied = t->nr_of_elements + t->nr_of_removed + n;
+	if (occupied <= t->capacity * MAX_LOAD_FACTOR) {
+		return;
+	}
+	rehash(t, capacity_for(t->nr_of_elements + n));
+}
+
+/**
+ * compact_if_needed() - Clean up the table after a removal.
+ * @t: Table to manipulate.
+ *
+ * Rehashes the table if "removed" markers take up more than 
+ * MAX_REMOVED_FACTOR of the array, or if the elements take up less than 
+ * MIN_LOAD_FACTOR of it. The first case keeps searches from probing through
+ * long runs of markers in tables with many removals, the second case returns
+ * memory once most elements are gone.
+ *
+ * Returns: Nothing.
+ */
+static void compact_if_needed(table *t)
+{
+	bool many_removed = t->nr_of_removed > t->capacity * MAX_REMOVED_FACTOR;
+	bool few_elements = t->capacity > INITIAL_CAPACITY 
+			    && t->nr_of_elements < t->capacity * MIN_LOAD_FACTOR;
+	if (many_removed || few_elements) {
+		rehash(t, capacity_for(t->nr_of_elements));
+	}
+}
+
+/**
+ * table_empty_hash() - Create an empty table with a given hash function.
  * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ *		   If NULL, hash_int() is used.
  * @key_free_func: A pointer to a function (or NULL) to be called to
  *		   de-allocate memory for keys on remove/kill.
  * @value_free_func: A pointer to a function (or NULL) to be called to
@@ -87,24 +273,50 @@ unsigned int hash_function(const void *key)
  *
  * Returns: Pointer to a new table.
  */
-table *table_empty(compare_function *key_cmp_func,
-		   free_function key_free_func,
-		   free_function value_free_func)
+table *table_empty_hash(compare_function *key_cmp_func,
+			hash_function *key_hash_func,
+			free_function key_free_func,
+			free_function value_free_func)
 {
 	// Allocate the table header.
 	table *t = calloc(1, sizeof(table));
-	// Create the array to hold the table_entry-ies. Size of table will be 
-	// [0, TABLE_SIZE-1].
-	t->entries = array_1d_create(0 ,TABLE_SIZE-1 , NULL);
-	// Store the key compare function and key/value free functions.
+	// Create the array of empty slots. Size of table will be 
+	// [0, INITIAL_CAPACITY-1] and will grow as elements are inserted.
+	t->entries = calloc(INITIAL_CAPACITY, sizeof(*t->entries));
+	t->capacity = INITIAL_CAPACITY;
+	t->first_full = INITIAL_CAPACITY;
+	// Store the key compare and hash functions and key/value free 
+	// functions.
 	t->key_cmp_func = key_cmp_func;
+	t->key_hash_func = key_hash_func != NULL ? key_hash_func : hash_int;
 	t->key_free_func = key_free_func;
 	t->value_free_func = value_free_func;
 	t->nr_of_elements = 0;
+	t->nr_of_removed = 0;
 	
 	return t;
 }
 
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Keys are hashed with hash_int().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	return table_empty_hash(key_cmp_func, NULL, key_free_func, 
+				value_free_func);
+}
+
 /**
  * table_is_empty() - Check if a table is empty.
  * @table: Table to check.
@@ -117,73 +329,132 @@ bool table_is_empty(const table *t)
 }
 
 /**
- * table_insert() - Add a key/value pair to a table.
- * @table: Table to manipulate.
+ * insert_hashed() - Add a key/value pair with a known hash to a table.
+ * @t: Table to manipulate.
  * @key: A pointer to the key value.
  * @value: A pointer to the value value.
+ * @hash: Hash value of the key.
  *
- * Insert the key/value pair into the table. A call upon the hash function 
- * generates an index in the array for the given key. Checks for key duplicates
- * and previously populated elements are performed for the position given by the
- * hash. Duplicates are removed and collisions are dealt with closed, quadratic 
- * increments of the position in the array.
+ * Does the work of table_insert(). The caller must have made room for the
+ * element with grow_if_needed().
  *
  * Returns: Nothing.
  */
-void table_insert(table *t, void *key, void *value)
+static void insert_hashed(table *t, void *key, void *value, uint32_t hash)
 {
-	// hash_function to find hash value of key
-	unsigned int hash = hash_function(key); 
+	// Reduce the hash value to an array index.
+	unsigned int mask = t->capacity - 1;
+	unsigned int pos = hash & mask;
+
+	// Remember the first "removed" marker on the way, it can be reused if
+	// the key turns out not to be in the table.
+	struct table_entry *removed_entry = NULL;
 
-	// While hash position is not empty, check for "removed key" marker and
-	// key duplicate. 
+	// While the slot is not empty, check for "removed" marker and key 
+	// duplicate. 
 	int i = 0;
-	while (array_1d_has_value(t->entries, hash)) {
-		
-		// Inspect table entry
-		struct table_entry *current_entry; 
-		current_entry = array_1d_inspect_value(t->entries, hash);
-		
-		// Check for "removed" marker, i.e. current table_entry has
-		// key and value pointers both set to NULL.    	
-		if (current_entry->key == NULL && current_entry->value == NULL) {
-			// This position is free, but has previously held an
-			// element. Set pointers, increment element count and 
-			// exit.
-			current_entry->key = key;
-			current_entry->value = value;
-			t->nr_of_elements++;
-			return;  
-		}
-		
-		// Check if keys match in current table_entry
-		if ((t->key_cmp_func(current_entry->key, key)) == 0) {
+	while (t->entries[pos].state != SLOT_EMPTY) {
+		struct table_entry *entry = &t->entries[pos];
+
+		if (entry->state == SLOT_REMOVED) {
+			if (removed_entry == NULL) {
+				removed_entry = entry;
+			}
+		} else if (entry->hash == hash 
+			   && t->key_cmp_func(entry->key, key) == 0) {
 			// If we have a key match, call free function for the 
 			// old key/value pair of this entry. 
 			if (t->key_free_func != NULL) {
-				t->key_free_func(current_entry->key);
+				t->key_free_func(entry->key);
 			}
 			if (t->value_free_func != NULL) {
-				t->value_free_func(current_entry->value);
+				t->value_free_func(entry->value);
 			}
 			// Set pointer to new key/value pointers and exit.
-			current_entry->key = key;
-			current_entry->value = value;
+			entry->key = key;
+			entry->value = value;
 			return;			
 		}
-		// Increment hash position quadratically.
+		// Increment position quadratically.
 		i++;
-		hash = (hash + i*i) % TABLE_SIZE;
+		pos = (pos + i) & mask;
 	}
-	// Current position in table is empty, allocate and insert new key/value 
-	// structure at this position.
-	struct table_entry *entry = malloc(sizeof(struct table_entry));	
-	entry->key = key;
-	entry->value = value;	
 	
-	// Set pointer to table entry in array and increment element count.
-	array_1d_set_value(t->entries, entry, hash);
+	struct table_entry *entry;
+	if (removed_entry != NULL) {
+		// The key is not in the table. Reuse the slot that has 
+		// previously held an element.
+		entry = removed_entry;
+		t->nr_of_removed--;
+	} else {
+		// Use the empty slot that ended the search.
+		entry = &t->entries[pos];
+	}
+	entry->key = key;
+	entry->value = value;
+	entry->hash = hash;
+	entry->state = SLOT_FULL;
 	t->nr_of_elements++;		
+
+	// Keep track of the first full slot.
+	if (entry - t->entries < t->first_full) {
+		t->first_full = entry - t->entries;
+	}
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. A call upon the hash function 
+ * generates an index in the array for the given key. Checks for key duplicates
+ * and previously populated elements are performed for the position given by the
+ * hash. Duplicates are removed and collisions are dealt with closed, quadratic 
+ * increments of the position in the array.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	// Make sure there is room for a new element before searching. 
+	grow_if_needed(t, 1);
+	insert_hashed(t, key, value, t->key_hash_func(key));
+}
+
+/**
+ * find_entry() - Find the slot holding a given key.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ * @hash: Hash value of the key.
+ *
+ * The hash value gives an index corresponding to the key value. Until the
+ * matching key is found or we reach an empty slot, increment the position
+ * quadratically, checking key values and skipping over "removed" markers.
+ * Keys are only compared if the stored hash matches.
+ *
+ * Returns: Pointer to the slot holding the key, or NULL if the key is not 
+ * 	    found in the table.
+ */
+static struct table_entry *find_entry(const table *t, const void *key, 
+				      uint32_t hash)
+{
+	unsigned int mask = t->capacity - 1;
+	unsigned int pos = hash & mask;
+
+	int i = 0;	
+	while (t->entries[pos].state != SLOT_EMPTY) {
+		struct table_entry *entry = &t->entries[pos];
+		if (entry->state == SLOT_FULL && entry->hash == hash
+		    && t->key_cmp_func(entry->key, key) == 0) {
+			return entry;
+		}
+		// Continue and increment position quadratically.
+		i++;
+		pos = (pos + i) & mask;
+	}
+	return NULL;
 }
 
 /**
@@ -191,52 +462,92 @@ void table_insert(table *t, void *key, void *value)
  * @table: Table to inspect.
  * @key: Key to look up.
  *
- * A call to the hash function generates an index corresponding to the key 
- * value. Until the matching key is found or we reach an empty array element, 
- * increment the hash position quadratically, checking key values and 
- * skipping over "removed" markers. 
- * 
  * Returns: The value corresponding to a given key, or NULL if the key
  * is not found in the table.
  */
 void *table_lookup(const table *t, const void *key)
 {
-	// hash_function to find hash value of key
-	unsigned int hash = hash_function(key);
-	
-	// While hash position is not empty, check for key match.
-	int i = 0;	
-	while (array_1d_has_value(t->entries, hash)) {
-	
-		// Inspect table entry
-		struct table_entry *entry; 
-		entry = array_1d_inspect_value(t->entries, hash);
-		
-		// Check that the current position does not have the "removed" 
-		// marker. Key/value pointers = NULL indicates removed 
-		// element. 
-		if (entry->key != NULL && entry->value != NULL) {
-			// Check if keys match
-			if ((t->key_cmp_func(entry->key, key)) == 0) {
-				// If yes, return corresponding value pointer
-				return entry->value;	
-			}	
+	struct table_entry *entry = find_entry(t, key, t->key_hash_func(key));
+	if (entry == NULL) {
+		// No match found, return NULL. 
+		return NULL;
+	}
+	return entry->value;
+}
+
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Equivalent to calling table_insert() for each pair in order. The keys are
+ * handled in batches of BATCH_SIZE. Room for a whole batch is made up 
+ * front, then all keys of the batch are hashed and their first slots are 
+ * prefetched, so that the cache misses of the batch overlap instead of 
+ * being taken one at a time.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values, 
+		       int n)
+{
+	uint32_t hashes[BATCH_SIZE];
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+
+		// No rehash may happen within the batch.
+		grow_if_needed(t, count);
+		unsigned int mask = t->capacity - 1;
+		for (int j = 0; j < count; j++) {
+			hashes[j] = t->key_hash_func(keys[start + j]);
+			__builtin_prefetch(&t->entries[hashes[j] & mask]);
+		}
+		for (int j = 0; j < count; j++) {
+			insert_hashed(t, keys[start + j], values[start + j], 
+				      hashes[j]);
+		}
+	}
+}
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Equivalent to calling table_lookup() for each key. The keys are handled in
+ * batches of BATCH_SIZE, where all keys of the batch are hashed and their 
+ * first slots are prefetched before any slot is inspected.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values, 
+		       int n)
+{
+	uint32_t hashes[BATCH_SIZE];
+	unsigned int mask = t->capacity - 1;
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+		for (int j = 0; j < count; j++) {
+			hashes[j] = t->key_hash_func(keys[start + j]);
+			__builtin_prefetch(&t->entries[hashes[j] & mask]);
+		}
+		for (int j = 0; j < count; j++) {
+			struct table_entry *entry;
+			entry = find_entry(t, keys[start + j], hashes[j]);
+			values[start + j] = entry != NULL ? entry->value : NULL;
 		}
-		
-		// Continue and increment hash position quadratically.
-		i++;
-		hash = (hash + i*i) % TABLE_SIZE;
 	}
-	// No match found, return NULL. 
-	return NULL;
-	
 }
 
 /**
  * table_choose_key() - Return an arbitrary key.
  * @t: Table to inspect.
  *
- * Return an arbitrary key stored in the table. Can be used together
+ * Return the key of the first full slot in the array. Can be used together
  * with table_remove() to deconstruct the table. Undefined for an
  * empty table.
  *
@@ -244,34 +555,9 @@ void *table_lookup(const table *t, const void *key)
  */
 void *table_choose_key(const table *t)
 {
-	// Search for the first non-NULL key in the array.
-	int i = 0;
-	bool searching = true;
-	struct table_entry *entry;
-	
-	while (searching) {	
-		// Check if current position is nonempty
-		if (array_1d_has_value(t->entries, i)) {
-		
-			// Inspect table entry
-			entry = array_1d_inspect_value(t->entries, i);
-			
-			// Check if element has the removed marker
-			if (entry->key != NULL && entry->value != NULL) {
-				// Current element is legit, exit the search.
-				searching = false;
-			} else {
-				// Current element has the removed marker, 
-				// continue the search.
-				i++;
-			}
-		} else {
-			// Current position in array is empty, continue search.
-			i++;
-		}
-	}
-	// Return the key.
-	return entry->key;
+	// The position of the first full slot is kept up to date by insert
+	// and remove.
+	return t->entries[t->first_full].key;
 }
 
 /**
@@ -281,53 +567,50 @@ void *table_choose_key(const table *t)
  *
  * Places a "removed" marker at the position of the key/value pair. Will call 
  * any free functions set for keys/values. Does nothing if key is not found in
- * the table.
+ * the table. The table is rehashed if too many markers have accumulated, or
+ * if it has become sparsely populated.
  *
  * Returns: Nothing.
  */
 void table_remove(table *t, const void *key)
 {
-	// hash_function to find hash value of key
-	unsigned int hash = hash_function(key);
-	
-	// While hash position is not empty, check for key match.
-	int i = 0;	
-	while (array_1d_has_value(t->entries, hash)) { 
-		
-		// Inspect table entry
-		struct table_entry *entry; 
-		entry = array_1d_inspect_value(t->entries, hash);
-		
-		// Check if current element has the "removed" marker, if yes 
-		// skip this element and continue with the search.
-		if (entry->key != NULL && entry->value != NULL) {
-		
-			// Check if keys match
-			if ((t->key_cmp_func(entry->key, key)) == 0) {
-				
-				// If yes, deallocate corresponding key & value
-				if (t->key_free_func != NULL) {
-					t->key_free_func(entry->key);
-				}
-				if (t->value_free_func != NULL) {
-					t->value_free_func(entry->value);
-				}
-				
-				// Leave the table_entry, but set key and value 
-				// pointers to NULL. This is the indication of a
-				// removed element.
-				entry->key = NULL; 
-				entry->value = NULL;
-				
-				// Decrement count of table elements
-				t->nr_of_elements--;
-				return;					
-			}	
+	struct table_entry *entry = find_entry(t, key, t->key_hash_func(key));
+	if (entry == NULL) {
+		return;
+	}
+
+	// Take a copy of the pointers, key may point to the same memory as 
+	// entry->key.
+	void *old_key = entry->key;
+	void *old_value = entry->value;
+
+	// Mark the slot as removed and decrement count of table elements.
+	entry->key = NULL;
+	entry->value = NULL;
+	entry->state = SLOT_REMOVED;
+	t->nr_of_elements--;
+	t->nr_of_removed++;
+
+	// If this was the first full slot, search for the next one. Repeated
+	// removal of the chosen key thus scans the array only once.
+	int i = t->first_full;
+	if (entry - t->entries == i) {
+		while (i < t->capacity && t->entries[i].state != SLOT_FULL) {
+			i++;
 		}
-		// Continue the search and increment hash position quadratically
-		i++;
-		hash = (hash + i*i) % TABLE_SIZE;	
+		t->first_full = i;
+	}
+
+	// Deallocate corresponding key & value.
+	if (t->key_free_func != NULL) {
+		t->key_free_func(old_key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(old_value);
 	}
+
+	// Get rid of the markers if they have piled up.
+	compact_if_needed(t);
 }
 
 /*
@@ -343,28 +626,21 @@ void table_remove(table *t, const void *key)
  */
 void table_kill(table *t)
 {
-	for (int i = 0; i < TABLE_SIZE; i++) {
-		// Check if for nonempty array elements
-		if (array_1d_has_value(t->entries, i)) {
-			
-			// Inspect element
-			struct table_entry *entry; 
-			entry = array_1d_inspect_value(t->entries, i);
-			
-			// If freeing functions are sepcified and key/value 
-			// pointers are not NULL, deallocate key/value.		
-			if (t->key_free_func != NULL && entry->key != NULL) {
-				t->key_free_func(entry->key);
-			}
-			if (t->value_free_func != NULL && entry->value != NULL) {
-				t->value_free_func(entry->value);
-			}
-			// Free current table_entry 
-			free(entry);
+	for (int i = 0; i < t->capacity; i++) {
+		// Deallocate key/value of full slots if freeing functions are
+		// specified.
+		if (t->entries[i].state != SLOT_FULL) {
+			continue;
+		}
+		if (t->key_free_func != NULL) {
+			t->key_free_func(t->entries[i].key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(t->entries[i].value);
 		}
 	}
 	// Destroy the rest of the table structure
-	array_1d_kill(t->entries);
+	free(t->entries);
 	free(t);
 }
 
@@ -380,11 +656,54 @@ void table_kill(table *t)
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
-	for (int i = 0; i < TABLE_SIZE; i++) {
-		if (array_1d_has_value(t->entries, i)) {
-			struct table_entry *e = array_1d_inspect_value(t->entries, i);	
-			print_func(e->key, e->value);
+	for (int i = 0; i < t->capacity; i++) {
+		if (t->entries[i].state == SLOT_FULL) {
+			print_func(t->entries[i].key, t->entries[i].value);
 		}
 	}
 }
 
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	// Start at the first full slot.
+	it->t = t;
+	it->pos = NULL;
+	it->index = t->first_full;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	// Skip empty slots and "removed" markers.
+	const table *t = it->t;
+	while (it->index < t->capacity 
+	       && t->entries[it->index].state != SLOT_FULL) {
+		it->index++;
+	}
+	if (it->index >= t->capacity) {
+		return false;
+	}
+	if (key != NULL) {
+		*key = t->entries[it->index].key;
+	}
+	if (value != NULL) {
+		*value = t->entries[it->index].value;
+	}
+	it->index++;
+	return true;
+}
@@ -0,0 +1,42 @@
+#ifndef __HASHTABLE_H
+#define __HASHTABLE_H
+
+#include "table.h"
+#include "hash.h"
+
+/*
+ * Extensions to the generic table interface in table.h for the hash based
+ * table implementations of OU4 (hashtable.c, swisstable.c). A table created
+ * with table_empty() hashes its keys with hash_int(). Tables with other kinds
+ * of keys, e.g. strings, should be created with table_empty_hash() and a 
+ * matching hash function, see hash.h. All other operations are the ones 
+ * declared in table.h.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ *   2026-10-17: v1.1, hash functions moved to hash.h.
+ */
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * table_empty_hash() - Create an empty table with a given hash function.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ *		   If NULL, hash_int() is used.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hash(compare_function key_cmp_func,
+			hash_function key_hash_func,
+			free_function key_free_func,
+			free_function value_free_func);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef __ORDEREDTABLE_H
+#define __ORDEREDTABLE_H
+
+#include "table.h"
+
+/*
+ * Extensions to the generic table interface in table.h for the ordered
+ * table implementations of OU4 (sortedtable.c, btreetable.c). These tables
+ * keep their keys ordered by the compare function given to table_empty(),
+ * so ranges of keys can be visited without a full scan. The iteration
+ * functions in table.h visit the key/value pairs in key order for these
+ * tables.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * table_lookup_range() - Visit all key/value pairs in a range of keys.
+ * @t: Table to inspect.
+ * @lo: Smallest key to visit.
+ * @hi: Largest key to visit.
+ * @inspect_func: Function called for each key/value pair with a key k such
+ *		  that lo <= k <= hi. The pairs are visited in key order.
+ *
+ * The table must not be modified by inspect_func.
+ *
+ * Returns: The number of visited key/value pairs.
+ */
+int table_lookup_range(const table *t, const void *lo, const void *hi,
+		       inspect_callback_pair inspect_func);
+
+/**
+ * table_iter_seek() - Start an ordered iteration at a given key.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ * @key: Key to start at.
+ *
+ * Positions the iterator so that the first call to table_iter_next() returns
+ * the pair with the smallest key not less than the given key. Iteration then
+ * continues in key order to the end of the table.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_seek(const table *t, table_iter *it, const void *key);
+
+#endif
@@ -0,0 +1,524 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "orderedtable.h"
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. Table constructed as a dynamic array where the key/value pairs
+ * are kept sorted by key, according to the compare function of the table.
+ * Lookups are done by binary search. Insertions and removals shift the tail
+ * of the array one step.
+ *
+ * table_insert_many() sorts the new pairs once and merges them with the
+ * existing array, which makes it the preferred way to build a table that is
+ * mostly read.
+ *
+ * Duplicates are handled at element insertion. The iteration functions
+ * visit the pairs in key order.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Based on arraytable.c and earlier code by: Niclas Borlin (niclas@cs.umu.se),
+ *	   	 	     Adam Dahlgren Lindstrom (dali@cs.umu.se),
+ * 			     Johan Eliasson (johane@cs.umu.se).
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ *   2026-10-17: v1.1, added table_lookup_range() and table_iter_seek().
+ */
+
+// ==================INTERNAL CONSTANTS=====================
+
+// Initial size of the array.
+#define INITIAL_CAPACITY 16
+
+// ==================INTERNAL DATA TYPES====================
+
+struct table_entry {
+	void *key;
+	void *value;
+};
+
+struct table {
+	struct table_entry *entries;
+	compare_function *key_cmp_func;
+	free_function key_free_func;
+	free_function value_free_func;
+	int capacity;
+	int nr_of_elements;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * reserve() - Make sure the array can hold a given number of elements.
+ * @t: Table to manipulate.
+ * @n: Number of elements the array should be able to hold.
+ *
+ * Doubles the size of the array until it can hold n elements.
+ *
+ * Returns: Nothing.
+ */
+static void reserve(table *t, int n)
+{
+	if (n <= t->capacity) {
+		return;
+	}
+	int capacity = t->capacity;
+	while (capacity < n) {
+		capacity *= 2;
+	}
+	t->entries = realloc(t->entries, capacity * sizeof(*t->entries));
+	t->capacity = capacity;
+}
+
+/**
+ * lower_bound() - Binary search for a key.
+ * @t: Table to inspect.
+ * @key: Key to search for.
+ *
+ * Returns: Index of the first element with a key not less than the given
+ * 	    key, or nr_of_elements if there is no such element.
+ */
+static int lower_bound(const table *t, const void *key)
+{
+	int lo = 0;
+	int hi = t->nr_of_elements;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		if (t->key_cmp_func(t->entries[mid].key, key) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/**
+ * find_index() - Find the index of a given key.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: Index of the element with the key, or -1 if the key is not found
+ * 	    in the table.
+ */
+static int find_index(const table *t, const void *key)
+{
+	int i = lower_bound(t, key);
+	if (i < t->nr_of_elements
+	    && t->key_cmp_func(t->entries[i].key, key) == 0) {
+		return i;
+	}
+	return -1;
+}
+
+/**
+ * free_entry() - Call the free functions for a key/value pair.
+ * @t: Table holding the free functions.
+ * @entry: Key/value pair to free.
+ *
+ * Returns: Nothing.
+ */
+static void free_entry(const table *t, struct table_entry *entry)
+{
+	if (t->key_free_func != NULL) {
+		t->key_free_func(entry->key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(entry->value);
+	}
+}
+
+/**
+ * merge_sort() - Sort key/value pairs by key.
+ * @t: Table holding the compare function.
+ * @entries: Array of n key/value pairs to sort.
+ * @tmp: Work array of at least n key/value pairs.
+ * @n: Number of pairs.
+ *
+ * Bottom-up merge sort. The sort is stable, i.e. pairs with equal keys keep
+ * their relative order.
+ *
+ * Returns: Nothing.
+ */
+static void merge_sort(const table *t, struct table_entry *entries,
+		       struct table_entry *tmp, int n)
+{
+	struct table_entry *src = entries;
+	struct table_entry *dst = tmp;
+	for (int width = 1; width < n; width *= 2) {
+		for (int lo = 0; lo < n; lo += 2 * width) {
+			int mid = lo + width < n ? lo + width : n;
+			int hi = lo + 2 * width < n ? lo + 2 * width : n;
+			int i = lo;
+			int j = mid;
+			int k = lo;
+			while (i < mid && j < hi) {
+				// Take from the left run on ties.
+				if (t->key_cmp_func(src[j].key, src[i].key) < 0) {
+					dst[k++] = src[j++];
+				} else {
+					dst[k++] = src[i++];
+				}
+			}
+			while (i < mid) {
+				dst[k++] = src[i++];
+			}
+			while (j < hi) {
+				dst[k++] = src[j++];
+			}
+		}
+		struct table_entry *swap = src;
+		src = dst;
+		dst = swap;
+	}
+	// Make sure the result ends up in entries.
+	if (src != entries) {
+		memcpy(entries, src, n * sizeof(*entries));
+	}
+}
+
+// ===========PUBLIC FUNCTION IMPLEMENTATIONS============
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	// Allocate the table header.
+	table *t = calloc(1, sizeof(table));
+	// Create the array to hold the key/value pairs. The array will grow
+	// as elements are inserted.
+	t->entries = malloc(INITIAL_CAPACITY * sizeof(*t->entries));
+	t->capacity = INITIAL_CAPACITY;
+	// Store the key compare function and key/value free functions.
+	t->key_cmp_func = key_cmp_func;
+	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+	t->nr_of_elements = 0;
+
+	return t;
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->nr_of_elements == 0;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. A binary search gives the
+ * position of the key. If the key is already in the table, the old
+ * key/value pair is replaced. Otherwise all following elements are shifted
+ * one step to make room for the new pair.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	int i = lower_bound(t, key);
+	if (i < t->nr_of_elements
+	    && t->key_cmp_func(t->entries[i].key, key) == 0) {
+		// If we have a key match, call free function for the old
+		// key/value pair and replace it.
+		free_entry(t, &t->entries[i]);
+		t->entries[i].key = key;
+		t->entries[i].value = value;
+		return;
+	}
+	// Shift the tail of the array to make room for the new pair.
+	reserve(t, t->nr_of_elements + 1);
+	memmove(&t->entries[i + 1], &t->entries[i],
+		(t->nr_of_elements - i) * sizeof(*t->entries));
+	t->entries[i].key = key;
+	t->entries[i].value = value;
+	t->nr_of_elements++;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	int i = find_index(t, key);
+	if (i < 0) {
+		// No match found, return NULL.
+		return NULL;
+	}
+	return t->entries[i].value;
+}
+
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Equivalent to calling table_insert() for each pair in order. The new pairs
+ * are sorted with a stable sort, duplicates among them are reduced to the
+ * last inserted pair, and the result is merged with the existing elements.
+ * Takes O(m + n log n) time for a table with m elements.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values,
+		       int n)
+{
+	if (n <= 0) {
+		return;
+	}
+	struct table_entry *batch = malloc(n * sizeof(*batch));
+	struct table_entry *tmp = malloc(n * sizeof(*tmp));
+	for (int i = 0; i < n; i++) {
+		batch[i].key = keys[i];
+		batch[i].value = values[i];
+	}
+	merge_sort(t, batch, tmp, n);
+
+	// Keep only the last of each run of equal keys.
+	int unique = 0;
+	for (int i = 0; i < n; i++) {
+		if (i + 1 < n
+		    && t->key_cmp_func(batch[i].key, batch[i + 1].key) == 0) {
+			free_entry(t, &batch[i]);
+		} else {
+			batch[unique++] = batch[i];
+		}
+	}
+
+	// Merge from the back, so the existing elements can stay in place
+	// until they are moved to their final position.
+	reserve(t, t->nr_of_elements + unique);
+	int i = t->nr_of_elements - 1;
+	int j = unique - 1;
+	int k = t->nr_of_elements + unique - 1;
+	int replaced = 0;
+	while (j >= 0) {
+		int cmp = i >= 0 ? t->key_cmp_func(t->entries[i].key,
+						   batch[j].key) : -1;
+		if (cmp > 0) {
+			t->entries[k--] = t->entries[i--];
+		} else {
+			if (cmp == 0) {
+				// The new pair replaces the old one.
+				free_entry(t, &t->entries[i--]);
+				replaced++;
+			}
+			t->entries[k--] = batch[j--];
+		}
+	}
+	// Close the gap left by replaced pairs, if any.
+	if (replaced > 0) {
+		memmove(&t->entries[i + 1], &t->entries[i + 1 + replaced],
+			(t->nr_of_elements + unique - replaced - i - 1)
+			* sizeof(*t->entries));
+	}
+	t->nr_of_elements += unique - replaced;
+
+	free(batch);
+	free(tmp);
+}
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values,
+		       int n)
+{
+	for (int i = 0; i < n; i++) {
+		values[i] = table_lookup(t, keys[i]);
+	}
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return the largest key in the table, which is the cheapest one to remove.
+ * Can be used together with table_remove() to deconstruct the table.
+ * Undefined for an empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+	return t->entries[t->nr_of_elements - 1].key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * A binary search gives the position of the key, and all following elements
+ * are shifted one step to fill the hole. Will call any free functions set for
+ * keys/values. Does nothing if key is not found in the table.
+ *
+ * Returns: Nothing.
+ */
+void table_remove(table *t, const void *key)
+{
+	int i = find_index(t, key);
+	if (i < 0) {
+		return;
+	}
+	// Take a copy of the pair, key may point to the same memory as the
+	// stored key.
+	struct table_entry entry = t->entries[i];
+	memmove(&t->entries[i], &t->entries[i + 1],
+		(t->nr_of_elements - i - 1) * sizeof(*t->entries));
+	t->nr_of_elements--;
+	free_entry(t, &entry);
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	for (int i = 0; i < t->nr_of_elements; i++) {
+		free_entry(t, &t->entries[i]);
+	}
+	free(t->entries);
+	free(t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table in key order and prints
+ * them.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	for (int i = 0; i < t->nr_of_elements; i++) {
+		print_func(t->entries[i].key, t->entries[i].value);
+	}
+}
+
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	// Start at the smallest key.
+	it->t = t;
+	it->pos = NULL;
+	it->index = 0;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * The pairs are visited in key order.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	const table *t = it->t;
+	if (it->index >= t->nr_of_elements) {
+		return false;
+	}
+	if (key != NULL) {
+		*key = t->entries[it->index].key;
+	}
+	if (value != NULL) {
+		*value = t->entries[it->index].value;
+	}
+	it->index++;
+	return true;
+}
+
+/**
+ * table_iter_seek() - Start an ordered iteration at a given key.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ * @key: Key to start at.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_seek(const table *t, table_iter *it, const void *key)
+{
+	it->t = t;
+	it->pos = NULL;
+	it->index = lower_bound(t, key);
+}
+
+/**
+ * table_lookup_range() - Visit all key/value pairs in a range of keys.
+ * @t: Table to inspect.
+ * @lo: Smallest key to visit.
+ * @hi: Largest key to visit.
+ * @inspect_func: Function called for each key/value pair in the range.
+ *
+ * Returns: The number of visited key/value pairs.
+ */
+int table_lookup_range(const table *t, const void *lo, const void *hi,
+		       inspect_callback_pair inspect_func)
+{
+	int count = 0;
+	for (int i = lower_bound(t, lo); i < t->nr_of_elements; i++) {
+		if (t->key_cmp_func(t->entries[i].key, hi) > 0) {
+			break;
+		}
+		inspect_func(t->entries[i].key, t->entries[i].value);
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,698 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "table.h"
+#include "hashtable.h"
+
+/*
+ * Implementation of a generic hash table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. Open addressing in the style of the "Swiss table": next to the
+ * array of key/value slots the table keeps an array of one byte control tags,
+ * one per slot. A control tag is either EMPTY, REMOVED or, for a full slot,
+ * the lowest 7 bits of the hash of the key.
+ *
+ * The arrays are divided into groups of GROUP_SIZE slots. The upper bits of
+ * the hash select the first group to search, and groups are then probed
+ * quadratically, as in hashtable.c. Within a group, all control tags are
+ * compared to the 7 hash bits of the key at once (with SSE2 if available), so
+ * the key compare function is only called for slots that match on 7 bits. A
+ * search ends at the first group that contains an EMPTY tag.
+ *
+ * Duplicates are handled at element insertion. A REMOVED tag is placed at
+ * element removal, unless the group of the slot already has an EMPTY tag.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Based on hashtable.c and earlier code by: Niclas Borlin (niclas@cs.umu.se),
+ *	   	 	     Adam Dahlgren Lindstrom (dali@cs.umu.se),
+ * 			     Johan Eliasson (johane@cs.umu.se).
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ *   2026-10-17: v1.1, constant time table_choose_key(), added 
+ *                     table_iter_begin() and table_iter_next().
+ *   2026-10-17: v1.2, added table_insert_many() and table_lookup_many().
+ */
+
+// ==================INTERNAL CONSTANTS=====================
+
+// Number of slots per group, matches the width of an SSE2 register.
+#define GROUP_SIZE 16
+
+// Initial size of the array, must be a power of two and at least GROUP_SIZE.
+#define INITIAL_CAPACITY 16
+
+// Max fraction of the array that may hold elements or REMOVED tags.
+#define MAX_LOAD_FACTOR 0.875
+
+// Number of keys hashed and prefetched ahead in table_insert_many() and
+// table_lookup_many().
+#define BATCH_SIZE 16
+
+// Control tags. Full slots hold 7 bits of the hash, i.e. 0-127.
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_REMOVED ((int8_t)-2)
+
+// ==================INTERNAL DATA TYPES====================
+
+struct table_entry {
+	void *key;
+	void *value;
+};
+
+struct table {
+	int8_t *ctrl;
+	struct table_entry *entries;
+	compare_function *key_cmp_func;
+	hash_function *key_hash_func;
+	free_function key_free_func;
+	free_function value_free_func;
+	int capacity;
+	int nr_of_elements;
+	int nr_of_removed;
+	int first_full;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * group_match() - Find the control tags in a group equal to a given tag.
+ * @ctrl: Pointer to the first control tag of the group.
+ * @tag: Tag to search for.
+ *
+ * Returns: Bit mask where bit i is set if ctrl[i] equals tag.
+ */
+static unsigned int group_match(const int8_t *ctrl, int8_t tag)
+{
+#ifdef __SSE2__
+	__m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+	__m128i match = _mm_cmpeq_epi8(group, _mm_set1_epi8(tag));
+	return (unsigned int)_mm_movemask_epi8(match);
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < GROUP_SIZE; i++) {
+		if (ctrl[i] == tag) {
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+#endif
+}
+
+/**
+ * group_match_free() - Find the non-full slots in a group.
+ * @ctrl: Pointer to the first control tag of the group.
+ *
+ * EMPTY and REMOVED are the only negative tags, so a slot is free if the sign
+ * bit of its tag is set.
+ *
+ * Returns: Bit mask where bit i is set if slot i is EMPTY or REMOVED.
+ */
+static unsigned int group_match_free(const int8_t *ctrl)
+{
+#ifdef __SSE2__
+	__m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+	return (unsigned int)_mm_movemask_epi8(group);
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < GROUP_SIZE; i++) {
+		if (ctrl[i] < 0) {
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+#endif
+}
+
+/**
+ * lowest_bit() - Index of the lowest set bit in a non-zero mask.
+ * @mask: Bit mask, must not be zero.
+ *
+ * Returns: Index of the lowest set bit.
+ */
+static int lowest_bit(unsigned int mask)
+{
+	return __builtin_ctz(mask);
+}
+
+/**
+ * hash_tag() - Control tag for a hash value.
+ * @hash: Hash value of the key.
+ *
+ * Returns: The lowest 7 bits of the hash.
+ */
+static int8_t hash_tag(uint64_t hash)
+{
+	return (int8_t)(hash & 0x7f);
+}
+
+/**
+ * hash_group() - First group to search for a hash value.
+ * @t: Table to inspect.
+ * @hash: Hash value of the key.
+ *
+ * Uses the hash bits above the 7 bits of the control tag.
+ *
+ * Returns: Index of the first group.
+ */
+static unsigned int hash_group(const table *t, uint64_t hash)
+{
+	unsigned int group_mask = t->capacity / GROUP_SIZE - 1;
+	return (unsigned int)(hash >> 7) & group_mask;
+}
+
+/**
+ * find_free_slot() - Find the first free slot in the probe sequence.
+ * @t: Table to inspect.
+ * @hash: Hash value of the key.
+ *
+ * Returns: Index of the first EMPTY or REMOVED slot in the probe sequence.
+ */
+static int find_free_slot(const table *t, uint64_t hash)
+{
+	unsigned int group_mask = t->capacity / GROUP_SIZE - 1;
+	unsigned int group = hash_group(t, hash);
+	int i = 0;
+	while (true) {
+		int base = group * GROUP_SIZE;
+		unsigned int mask = group_match_free(&t->ctrl[base]);
+		if (mask != 0) {
+			return base + lowest_bit(mask);
+		}
+		// Increment group quadratically.
+		i++;
+		group = (group + i) & group_mask;
+	}
+}
+
+/**
+ * find_slot() - Find the slot holding a given key.
+ * @t: Table to inspect.
+ * @key: Key to look up.
+ * @hash: Hash value of the key.
+ *
+ * Returns: Index of the slot holding the key, or -1 if the key is not found
+ * 	    in the table.
+ */
+static int find_slot(const table *t, const void *key, uint64_t hash)
+{
+	unsigned int group_mask = t->capacity / GROUP_SIZE - 1;
+	unsigned int group = hash_group(t, hash);
+	int8_t tag = hash_tag(hash);
+	int i = 0;
+	while (true) {
+		int base = group * GROUP_SIZE;
+		// Compare keys only for the slots with a matching tag.
+		unsigned int mask = group_match(&t->ctrl[base], tag);
+		while (mask != 0) {
+			int pos = base + lowest_bit(mask);
+			if (t->key_cmp_func(t->entries[pos].key, key) == 0) {
+				return pos;
+			}
+			mask &= mask - 1;
+		}
+		// An EMPTY tag in the group ends the search.
+		if (group_match(&t->ctrl[base], CTRL_EMPTY) != 0) {
+			return -1;
+		}
+		// Increment group quadratically.
+		i++;
+		group = (group + i) & group_mask;
+	}
+}
+
+/**
+ * rehash() - Move all elements of the table into new arrays.
+ * @t: Table to manipulate.
+ * @capacity: Size of the new arrays, must be a power of two and at least
+ * 	      GROUP_SIZE.
+ *
+ * Inserts all elements into new arrays of the given size and destroys the
+ * old arrays. All REMOVED tags are dropped in the process.
+ *
+ * Returns: Nothing.
+ */
+static void rehash(table *t, int capacity)
+{
+	int8_t *old_ctrl = t->ctrl;
+	struct table_entry *old_entries = t->entries;
+	int old_capacity = t->capacity;
+
+	t->ctrl = malloc(capacity * sizeof(*t->ctrl));
+	memset(t->ctrl, CTRL_EMPTY, capacity * sizeof(*t->ctrl));
+	t->entries = malloc(capacity * sizeof(*t->entries));
+	t->capacity = capacity;
+	t->nr_of_removed = 0;
+	t->first_full = capacity;
+
+	for (int j = 0; j < old_capacity; j++) {
+		if (old_ctrl[j] < 0) {
+			continue;
+		}
+		// Keys are unique, so just take the first free slot.
+		uint64_t hash = t->key_hash_func(old_entries[j].key);
+		int pos = find_free_slot(t, hash);
+		t->ctrl[pos] = hash_tag(hash);
+		t->entries[pos] = old_entries[j];
+		if (pos < t->first_full) {
+			t->first_full = pos;
+		}
+	}
+	free(old_ctrl);
+	free(old_entries);
+}
+
+/**
+ * grow_if_needed() - Make room for more elements in the table.
+ * @t: Table to manipulate.
+ * @n: Number of elements to make room for.
+ *
+ * Rehashes the table if n more occupied slots would push the load factor
+ * above MAX_LOAD_FACTOR. The new size is the smallest power of two that keeps
+ * the elements below half of the allowed load, so a table full of REMOVED
+ * tags may be rehashed without growing.
+ *
+ * Returns: Nothing.
+ */
+static void grow_if_needed(table *t, int n)
+{
+	int occupied = t->nr_of_elements + t->nr_of_removed + n;
+	if (occupied <= t->capacity * MAX_LOAD_FACTOR) {
+		return;
+	}
+	int capacity = INITIAL_CAPACITY;
+	while (2 * (t->nr_of_elements + n) > capacity * MAX_LOAD_FACTOR) {
+		capacity *= 2;
+	}
+	rehash(t, capacity);
+}
+
+/**
+ * table_empty_hash() - Create an empty table with a given hash function.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash keys.
+ *		   If NULL, hash_int() is used.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hash(compare_function *key_cmp_func,
+			hash_function *key_hash_func,
+			free_function key_free_func,
+			free_function value_free_func)
+{
+	// Allocate the table header.
+	table *t = calloc(1, sizeof(table));
+	// Create the control and slot arrays. Size of table will be
+	// [0, INITIAL_CAPACITY-1] and will grow as elements are inserted.
+	t->ctrl = malloc(INITIAL_CAPACITY * sizeof(*t->ctrl));
+	memset(t->ctrl, CTRL_EMPTY, INITIAL_CAPACITY * sizeof(*t->ctrl));
+	t->entries = malloc(INITIAL_CAPACITY * sizeof(*t->entries));
+	t->capacity = INITIAL_CAPACITY;
+	t->first_full = INITIAL_CAPACITY;
+	// Store the key compare and hash functions and key/value free
+	// functions.
+	t->key_cmp_func = key_cmp_func;
+	t->key_hash_func = key_hash_func != NULL ? key_hash_func : hash_int;
+	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+	t->nr_of_elements = 0;
+	t->nr_of_removed = 0;
+
+	return t;
+}
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Keys are hashed with hash_int().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	return table_empty_hash(key_cmp_func, NULL, key_free_func,
+				value_free_func);
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->nr_of_elements == 0;
+}
+
+/**
+ * insert_hashed() - Add a key/value pair with a known hash to a table.
+ * @t: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ * @hash: Hash value of the key.
+ * @room_made: True if the caller has made room for the element with
+ *	       grow_if_needed().
+ *
+ * Does the work of table_insert().
+ *
+ * Returns: Nothing.
+ */
+static void insert_hashed(table *t, void *key, void *value, uint64_t hash,
+			  bool room_made)
+{
+	// Check for key duplicate.
+	int pos = find_slot(t, key, hash);
+	if (pos >= 0) {
+		// If we have a key match, call free function for the old
+		// key/value pair of this entry.
+		struct table_entry *entry = &t->entries[pos];
+		if (t->key_free_func != NULL) {
+			t->key_free_func(entry->key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(entry->value);
+		}
+		// Set pointer to new key/value pointers and exit.
+		entry->key = key;
+		entry->value = value;
+		return;
+	}
+
+	// The key is not in the table. Make sure there is room for it and
+	// take the first free slot.
+	if (!room_made) {
+		grow_if_needed(t, 1);
+	}
+	pos = find_free_slot(t, hash);
+	if (t->ctrl[pos] == CTRL_REMOVED) {
+		t->nr_of_removed--;
+	}
+	t->ctrl[pos] = hash_tag(hash);
+	t->entries[pos].key = key;
+	t->entries[pos].value = value;
+	t->nr_of_elements++;
+
+	// Keep track of the first full slot.
+	if (pos < t->first_full) {
+		t->first_full = pos;
+	}
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key value.
+ * @value: A pointer to the value value.
+ *
+ * Insert the key/value pair into the table. If the key is already in the
+ * table, the old key/value pair is replaced. Otherwise the pair is placed in
+ * the first free slot of the probe sequence of the key.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	insert_hashed(t, key, value, t->key_hash_func(key), false);
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	int pos = find_slot(t, key, t->key_hash_func(key));
+	if (pos < 0) {
+		// No match found, return NULL.
+		return NULL;
+	}
+	return t->entries[pos].value;
+}
+
+/**
+ * prefetch_group() - Prefetch the first group to search for a hash value.
+ * @t: Table to inspect.
+ * @hash: Hash value of the key.
+ *
+ * Returns: Nothing.
+ */
+static void prefetch_group(const table *t, uint64_t hash)
+{
+	int base = hash_group(t, hash) * GROUP_SIZE;
+	__builtin_prefetch(&t->ctrl[base]);
+	__builtin_prefetch(&t->entries[base]);
+}
+
+/**
+ * table_insert_many() - Add several key/value pairs to a table.
+ * @t: Table to manipulate.
+ * @keys: Array of n pointers to key values.
+ * @values: Array of n pointers to value values.
+ * @n: Number of key/value pairs to insert.
+ *
+ * Equivalent to calling table_insert() for each pair in order. The keys are
+ * handled in batches of BATCH_SIZE. Room for a whole batch is made up
+ * front, then all keys of the batch are hashed and their first groups are
+ * prefetched, so that the cache misses of the batch overlap instead of
+ * being taken one at a time.
+ *
+ * Returns: Nothing.
+ */
+void table_insert_many(table *t, void *const *keys, void *const *values,
+		       int n)
+{
+	uint64_t hashes[BATCH_SIZE];
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+
+		// No rehash may happen within the batch.
+		grow_if_needed(t, count);
+		for (int j = 0; j < count; j++) {
+			hashes[j] = t->key_hash_func(keys[start + j]);
+			prefetch_group(t, hashes[j]);
+		}
+		for (int j = 0; j < count; j++) {
+			insert_hashed(t, keys[start + j], values[start + j],
+				      hashes[j], true);
+		}
+	}
+}
+
+/**
+ * table_lookup_many() - Look up several keys in a table.
+ * @t: Table to inspect.
+ * @keys: Array of n pointers to keys to look up.
+ * @values: Array of n pointers where the values are stored.
+ * @n: Number of keys to look up.
+ *
+ * Equivalent to calling table_lookup() for each key. The keys are handled in
+ * batches of BATCH_SIZE, where all keys of the batch are hashed and their
+ * first groups are prefetched before any group is inspected.
+ *
+ * Returns: Nothing.
+ */
+void table_lookup_many(const table *t, void *const *keys, void **values,
+		       int n)
+{
+	uint64_t hashes[BATCH_SIZE];
+	for (int start = 0; start < n; start += BATCH_SIZE) {
+		int count = n - start < BATCH_SIZE ? n - start : BATCH_SIZE;
+		for (int j = 0; j < count; j++) {
+			hashes[j] = t->key_hash_func(keys[start + j]);
+			prefetch_group(t, hashes[j]);
+		}
+		for (int j = 0; j < count; j++) {
+			int pos = find_slot(t, keys[start + j], hashes[j]);
+			values[start + j] = pos >= 0 ? t->entries[pos].value 
+						     : NULL;
+		}
+	}
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return the key of the first full slot in the array. Can be used together
+ * with table_remove() to deconstruct the table. Undefined for an
+ * empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+	// The position of the first full slot is kept up to date by insert
+	// and remove.
+	return t->entries[t->first_full].key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Will call any free functions set for keys/values. Does nothing if key is
+ * not found in the table.
+ *
+ * Returns: Nothing.
+ */
+void table_remove(table *t, const void *key)
+{
+	int pos = find_slot(t, key, t->key_hash_func(key));
+	if (pos < 0) {
+		return;
+	}
+
+	// Take a copy of the pointers, key may point to the same memory as
+	// the stored key.
+	void *old_key = t->entries[pos].key;
+	void *old_value = t->entries[pos].value;
+
+	// If the group already has an EMPTY tag, no search continues past it
+	// and the slot can be marked EMPTY. Otherwise a REMOVED tag is needed
+	// to keep searches going.
+	int base = pos - pos % GROUP_SIZE;
+	if (group_match(&t->ctrl[base], CTRL_EMPTY) != 0) {
+		t->ctrl[pos] = CTRL_EMPTY;
+	} else {
+		t->ctrl[pos] = CTRL_REMOVED;
+		t->nr_of_removed++;
+	}
+	t->nr_of_elements--;
+
+	// If this was the first full slot, search for the next one. Repeated
+	// removal of the chosen key thus scans the array only once.
+	if (pos == t->first_full) {
+		int i = pos;
+		while (i < t->capacity && t->ctrl[i] < 0) {
+			i++;
+		}
+		t->first_full = i;
+	}
+
+	// Deallocate corresponding key & value.
+	if (t->key_free_func != NULL) {
+		t->key_free_func(old_key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(old_value);
+	}
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	for (int i = 0; i < t->capacity; i++) {
+		// Deallocate key/value of full slots if freeing functions are
+		// specified.
+		if (t->ctrl[i] < 0) {
+			continue;
+		}
+		if (t->key_free_func != NULL) {
+			t->key_free_func(t->entries[i].key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(t->entries[i].value);
+		}
+	}
+	// Destroy the rest of the table structure
+	free(t->ctrl);
+	free(t->entries);
+	free(t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table and prints them.
+ * Will print all stored elements, including duplicates.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	for (int i = 0; i < t->capacity; i++) {
+		if (t->ctrl[i] >= 0) {
+			print_func(t->entries[i].key, t->entries[i].value);
+		}
+	}
+}
+
+/**
+ * table_iter_begin() - Start an iteration over the table.
+ * @t: Table to iterate over.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	// Start at the first full slot.
+	it->t = t;
+	it->pos = NULL;
+	it->index = t->first_full;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next key/value pair.
+ * @it: Iterator to advance.
+ * @key: Pointer to where the key should be stored, or NULL.
+ * @value: Pointer to where the value should be stored, or NULL.
+ *
+ * Returns: True if a key/value pair was found, false if the iteration has
+ * reached the end of the table.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	// Skip EMPTY and REMOVED slots.
+	const table *t = it->t;
+	while (it->index < t->capacity && t->ctrl[it->index] < 0) {
+		it->index++;
+	}
+	if (it->index >= t->capacity) {
+		return false;
+	}
+	if (key != NULL) {
+		*key = t->entries[it->index].key;
+	}
+	if (value != NULL) {
+		*value = t->entries[it->index].value;
+	}
+	it->index++;
+	return true;
+}
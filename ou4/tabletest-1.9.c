@@ -61,8 +61,22 @@
  *    that it is gone and that the other key returns the cocorrect
  *    value. The second key is removed and it is checked that the
  *    table is empty.
+ * 9. Tests a table by creating it and inserting three key-value-pairs.
+ *    After that it is checked that an iteration visits each pair exactly
+ *    once, and that table_choose_key() and table_remove() empties the
+ *    table in three steps.
+ * 10. Tests a table by creating it and inserting three key-value-pairs,
+ *    two of them with the same key, with a single call to
+ *    table_insert_many(). After that, table_lookup_many() is used to look
+ *    up both keys and a missing key, and the returned values are checked.
+ * 11. Only for the ordered tables, compiled with ORDERED_TABLE defined.
+ *    Tests table_lookup_range() and table_iter_seek() by inserting keys in
+ *    random order and checking ranges and iterations from given keys,
+ *    both in and between the keys, before and after removing keys.
  *
  * There is also a module measuring time for insertions, lookups etc.
+ * With -b, the insertions and lookups are also timed with the batch
+ * functions table_insert_many() and table_lookup_many().
  * */
 #include <stdbool.h>
 #include <stdio.h>
@@ -70,6 +84,9 @@
 #include <string.h>
 #include <sys/time.h>
 #include "table.h"
+#ifdef ORDERED_TABLE
+#include "orderedtable.h"
+#endif
 
 // Maximum size of the table to generate
 #define TABLESIZE 40000
@@ -328,6 +345,116 @@ void get_skewed_lookup_speed(table *t, int *keys, int n, bool machine_table)
 	}
 }
 
+/* Create an array of dynamic copies of integers. The array itself should
+ * be freed by the caller, the copies are handed over to a table.
+ *    ints - a list of integers to copy
+ *    n - the number of integers to copy
+ */
+void **int_ptrs_from_ints(int *ints, int n)
+{
+        void **ptrs = malloc(n*sizeof(void *));
+        for(int i=0;i<n;i++) {
+                ptrs[i] = int_ptr_from_int(ints[i]);
+        }
+        return ptrs;
+}
+
+/* Measures time taken to fill a table with values with a single call to
+ * table_insert_many(). The copies of the items are made before the clock
+ * is started.
+ *    table - the table to fill
+ *    keys - a list of keys to use
+ *    values - a list of values to use
+ *    n - the number of items to insert
+ *    machine_table - true if we should output a machine-readable table
+ */
+void get_batch_insert_speed(table *t, int *keys, int *values, int n,
+		bool machine_table)
+{
+        unsigned long start;
+        unsigned long end;
+
+        void **key_ptrs = int_ptrs_from_ints(keys, n);
+        void **value_ptrs = int_ptrs_from_ints(values, n);
+
+        start = get_milliseconds();
+        table_insert_many(t, key_ptrs, value_ptrs, n);
+        end = get_milliseconds();
+        free(key_ptrs);
+        free(value_ptrs);
+	if (machine_table) {
+		printf("%d, %d, %lu\n",6,n,end-start);
+	} else {
+		printf("Batch insert %5d items             : ", n);
+		printf("%lu ms.\n",end-start);
+	}
+}
+
+/* Measures time taken to look up a list of keys in a table with a single
+ * call to table_lookup_many(). The found values are discarded.
+ *    t - the table to search
+ *    lookup_keys - a list of pointers to the keys to look up
+ *    n - the number of lookups to perform
+ *
+ * Returns: The time taken by the lookups in milliseconds.
+ */
+unsigned long time_batch_lookups(table *t, void **lookup_keys, int n)
+{
+        unsigned long start;
+        unsigned long end;
+
+        void **found = malloc(n*sizeof(void *));
+        start = get_milliseconds();
+        table_lookup_many(t, lookup_keys, found, n);
+        end = get_milliseconds();
+        free(found);
+        return end-start;
+}
+
+/* Measures time taken to do n batch lookups of the same kinds of keys as
+ * the single lookup tests above. The list of keys is made before the clock
+ * is started.
+ *    t - the table to search
+ *    keys - a list of keys to use
+ *    n - the number of lookups to perform
+ *    test_nr - 7 for non-existing keys, 8 for random existing keys and 9
+ *              for existing keys from the middle third of the keys
+ *    machine_table - true if we should output a machine-readable table
+ */
+void get_batch_lookup_speed(table *t, int *keys, int n, int test_nr,
+			    bool machine_table)
+{
+        void **lookup_keys = malloc(n*sizeof(void *));
+        int startindex = n/3;
+        int partition = n*2/3 - startindex + 1;
+        for(int i=0;i<n;i++) {
+                int pos;
+                if (test_nr==7) {
+                        // Keys in [TABLESIZE, 2*TABLESIZE-1] do not exist
+                        pos = n + i;
+                } else if (test_nr==8) {
+                        pos = rand()%n;
+                } else {
+                        pos = rand()%partition + startindex;
+                }
+                lookup_keys[i] = &keys[pos];
+        }
+        unsigned long elapsed = time_batch_lookups(t, lookup_keys, n);
+        free(lookup_keys);
+	if (machine_table) {
+		printf("%d, %d, %lu\n",test_nr,n,elapsed);
+	} else if (test_nr==7) {
+		printf("%5d batch lookups, missing keys    : ", n);
+		printf("%lu ms.\n", elapsed);
+	} else if (test_nr==8) {
+		printf("%5d random batch lookups           : ", n);
+		printf("%lu ms.\n", elapsed);
+	} else {
+		printf("%5d skewed batch lookups           : ", n);
+		printf("%lu ms.\n", elapsed);
+	}
+}
+
 /* Measures time taken remove all keys from a table
  *    t - the table to fill
  *    keys - a list of keys to use
@@ -681,6 +808,266 @@ void test_remove_elements_same_keys()
         table_kill(t);
 }
 
+/* Tests a table by creating it and inserting three key-value-pairs. After
+ *  that an iteration over the table is done, and it is checked that each
+ *  pair is visited exactly once with the correct value. Finally, the table
+ *  is deconstructed by repeated calls to table_choose_key() and
+ *  table_remove(), and it is checked that this takes exactly three steps.
+ *
+ *  It is assumed that test_insert_lookup_different_keys and
+ *  test_remove_elements_different_keys have been run before calling this
+ *  test.
+ */
+void test_iterate_and_choose_key()
+{
+        table *t = table_empty(string_compare, free, free);
+
+        char *keys[] = {"key1", "key2", "key3"};
+        char *values[] = {"value1", "value2", "value3"};
+        int visits[] = {0, 0, 0};
+
+        for (int i=0; i<3; i++) {
+                table_insert(t, copy_string(keys[i]), copy_string(values[i]));
+        }
+
+        table_iter it;
+        void *key;
+        void *value;
+        table_iter_begin(t, &it);
+        while (table_iter_next(&it, &key, &value)) {
+                int i;
+                for (i=0; i<3 && strcmp(key, keys[i]); i++) {
+                }
+                if (i==3 || strcmp(value, values[i])){
+                        printf("Iteration returned an unexpected key-value "
+                               "pair %s: %s.\n", (char *)key, (char *)value);
+                        exit(EXIT_FAILURE);
+                }
+                visits[i]++;
+        }
+        for (int i=0; i<3; i++) {
+                if (visits[i]!=1) {
+                        printf("Iteration visited key %s %d times.\n",
+                               keys[i], visits[i]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+
+        int steps = 0;
+        while (!table_is_empty(t) && steps<3) {
+                char *k = copy_string(table_choose_key(t));
+                table_remove(t, k);
+                test_lookup_missing_key(t, k);
+                free(k);
+                steps++;
+        }
+        if (!table_is_empty(t)) {
+                printf("Removing three chosen keys from a table with three "
+                       "elements does not result in an empty table.\n");
+                exit(EXIT_FAILURE);
+        }
+
+        printf("Iterating over three elements and removing chosen keys, "
+               "should end with empty table - OK\n");
+        table_kill(t);
+}
+
+/* Tests a table by inserting three key-value-pairs with a single call to
+ *  table_insert_many(), where the first and third pair have the same
+ *  key. After that, the two keys and a missing key are looked up with a
+ *  single call to table_lookup_many(), and it is checked that the last
+ *  inserted value is returned for the duplicate key and NULL for the
+ *  missing key.
+ *
+ *  It is assumed that test_insert_lookup_same_keys has been run before
+ *  calling this test.
+ */
+void test_insert_lookup_many()
+{
+        table *t = table_empty(string_compare, free, free);
+
+        void *keys[] = {copy_string("key1"), copy_string("key2"),
+                        copy_string("key1")};
+        void *values[] = {copy_string("value1"), copy_string("value2"),
+                          copy_string("value3")};
+        table_insert_many(t, keys, values, 3);
+
+        void *lookup_keys[] = {"key1", "key2", "key3"};
+        char *expected[] = {"value3", "value2", NULL};
+        void *found[3];
+        table_lookup_many(t, lookup_keys, found, 3);
+        for (int i=0; i<3; i++) {
+                if (expected[i]==NULL && found[i]!=NULL) {
+                        printf("Batch lookup of missing key %s returned "
+                               "value %s.\n", (char *)lookup_keys[i],
+                               (char *)found[i]);
+                        exit(EXIT_FAILURE);
+                }
+                if (expected[i]!=NULL &&
+                    (found[i]==NULL || strcmp(found[i], expected[i]))) {
+                        printf("Batch lookup of key %s did not return "
+                               "the expected value %s.\n",
+                               (char *)lookup_keys[i], expected[i]);
+                        exit(EXIT_FAILURE);
+                }
+        }
+
+        printf("Inserting and looking up three elements in batches - OK\n");
+        table_kill(t);
+}
+
+#ifdef ORDERED_TABLE
+// Number of keys in the range tests, enough for several B-tree levels.
+#define RANGE_TEST_KEYS 2000
+
+// Keys of the range tests are multiples of RANGE_TEST_STEP, so that there
+// are missing keys between any two keys in the table.
+#define RANGE_TEST_STEP 10
+
+// Keys visited by the last call to table_lookup_range().
+int range_visited[RANGE_TEST_KEYS];
+int nr_range_visited;
+
+/* Callback for table_lookup_range() that records the visited keys and
+ *  checks that each value is its key plus one.
+ */
+void record_range_pair(const void *key, const void *value)
+{
+        int k = *(const int *)key;
+        if (*(const int *)value != k + 1) {
+                printf("Range lookup visited key %d with value %d.\n", k,
+                       *(const int *)value);
+                exit(EXIT_FAILURE);
+        }
+        range_visited[nr_range_visited++] = k;
+}
+
+/* Checks that table_lookup_range() visits exactly the keys of the table
+ *  in [lo, hi], in key order.
+ *    present - present[i] is true if the key i*RANGE_TEST_STEP is in the
+ *              table
+ */
+void check_range(const table *t, const bool *present, int lo, int hi)
+{
+        nr_range_visited = 0;
+        int n = table_lookup_range(t, &lo, &hi, record_range_pair);
+        int expected = 0;
+        for (int i=0; i<RANGE_TEST_KEYS; i++) {
+                int k = i*RANGE_TEST_STEP;
+                if (!present[i] || k < lo || k > hi) {
+                        continue;
+                }
+                if (expected >= nr_range_visited
+                    || range_visited[expected] != k) {
+                        printf("Range lookup [%d, %d] did not visit key "
+                               "%d in order.\n", lo, hi, k);
+                        exit(EXIT_FAILURE);
+                }
+                expected++;
+        }
+        if (n != expected || nr_range_visited != expected) {
+                printf("Range lookup [%d, %d] visited %d keys, returned %d, "
+                       "expected %d.\n", lo, hi, nr_range_visited, n,
+                       expected);
+                exit(EXIT_FAILURE);
+        }
+}
+
+/* Checks that an iteration started by table_iter_seek() visits exactly the
+ *  keys of the table not less than the given key, in key order.
+ *    present - present[i] is true if the key i*RANGE_TEST_STEP is in the
+ *              table
+ */
+void check_seek(const table *t, const bool *present, int key)
+{
+        table_iter it;
+        table_iter_seek(t, &it, &key);
+        for (int i=0; i<RANGE_TEST_KEYS; i++) {
+                int k = i*RANGE_TEST_STEP;
+                if (!present[i] || k < key) {
+                        continue;
+                }
+                void *found_key;
+                void *found_value;
+                if (!table_iter_next(&it, &found_key, &found_value)
+                    || *(int *)found_key != k
+                    || *(int *)found_value != k + 1) {
+                        printf("Iteration from key %d did not visit key "
+                               "%d in order.\n", key, k);
+                        exit(EXIT_FAILURE);
+                }
+        }
+        void *found_key;
+        void *found_value;
+        if (table_iter_next(&it, &found_key, &found_value)) {
+                printf("Iteration from key %d visited key %d after the "
+                       "largest key.\n", key, *(int *)found_key);
+                exit(EXIT_FAILURE);
+        }
+}
+
+/* Checks ranges with lo > hi, lo == hi, bounds between keys and bounds
+ *  outside all keys, and iterations started at present keys, at missing
+ *  keys and outside all keys.
+ */
+void check_ranges_and_seeks(const table *t, const bool *present)
+{
+        int last = (RANGE_TEST_KEYS-1)*RANGE_TEST_STEP;
+        check_range(t, present, 100, 50);
+        check_range(t, present, 500, 500);
+        check_range(t, present, 505, 505);
+        check_range(t, present, -100, -1);
+        check_range(t, present, last+1, last+100);
+        check_range(t, present, -100, last+100);
+        for (int lo=-15; lo<=last+15; lo+=35) {
+                check_range(t, present, lo, lo+137);
+                check_range(t, present, lo, lo+1234);
+        }
+        check_seek(t, present, -100);
+        check_seek(t, present, last+1);
+        for (int key=-5; key<=last+5; key+=5) {
+                check_seek(t, present, key);
+        }
+}
+
+/* Tests the range functions of an ordered table, see orderedtable.h. Keys
+ *  that are multiples of ten are inserted in random order, each with the
+ *  value key+1. Ranges and iterations from a given key are checked against
+ *  the inserted keys. This is repeated after removing the smallest keys in
+ *  increasing order and every third key, which removes the first key of
+ *  many nodes and changes the separators that refer to them.
+ */
+void test_lookup_range_and_seek()
+{
+        table *t = table_empty(int_compare, free, free);
+        bool *present = calloc(RANGE_TEST_KEYS, sizeof(bool));
+
+        int *order = malloc(RANGE_TEST_KEYS*sizeof(int));
+        create_random_sample(order, RANGE_TEST_KEYS);
+        for (int i=0; i<RANGE_TEST_KEYS; i++) {
+                int k = order[i]*RANGE_TEST_STEP;
+                table_insert(t, int_ptr_from_int(k), int_ptr_from_int(k+1));
+                present[order[i]] = true;
+        }
+        free(order);
+        check_ranges_and_seeks(t, present);
+
+        for (int i=0; i<RANGE_TEST_KEYS; i++) {
+                if (i < RANGE_TEST_KEYS/10 || i%3 == 0) {
+                        int k = i*RANGE_TEST_STEP;
+                        table_remove(t, &k);
+                        present[i] = false;
+                }
+        }
+        check_ranges_and_seeks(t, present);
+
+        printf("Looking up ranges and iterating from given keys, also after "
+               "removals - OK\n");
+        free(present);
+        table_kill(t);
+}
+#endif
+
 /*  Tests a table by performing a set of tests. Program exits if any
  *  error is found.
  */
@@ -694,14 +1081,21 @@ void correctness_test()
         test_remove_single_element();
         test_remove_elements_different_keys();
         test_remove_elements_same_keys();
+        test_iterate_and_choose_key();
+        test_insert_lookup_many();
+#ifdef ORDERED_TABLE
+        test_lookup_range_and_seek();
+#endif
 }
 
 /* Tests the speed of a table using random numbers. First a number of
  * elements are inserted. Second a random lookup among the elements are
  * done followed by a skewed lookup (where a subset of the keys are
- * looked up more frequently). Finally all elements are removed.
+ * looked up more frequently). Finally all elements are removed. If batch
+ * is true, the insertions and lookups are then timed again with the batch
+ * functions.
  */
-void speed_test(int n,bool machine_table)
+void speed_test(int n,bool machine_table,bool batch)
 {
         int randomsize = 2*n; // To make it easier testing
                               // non-existing keys later
@@ -734,6 +1128,20 @@ void speed_test(int n,bool machine_table)
         get_skewed_lookup_speed(t, keys, n, machine_table);
         table_kill(t);
 
+        if (batch) {
+                t = table_empty(int_compare, free, free);
+                get_batch_insert_speed(t, keys, values, n, machine_table);
+                table_kill(t);
+
+                for (int test_nr=7; test_nr<=9; test_nr++) {
+                        t = table_empty(int_compare, free, free);
+                        insert_values(t,keys,values,n);
+                        get_batch_lookup_speed(t, keys, n, test_nr,
+                                               machine_table);
+                        table_kill(t);
+                }
+        }
+
         free(keys);
         free(values);
 }
@@ -744,6 +1152,7 @@ int main(int argc,char **argv)
 {
 	bool do_test=true; // Should we run the testing code?
 	bool machine_table=false; // Should we output a machine-readable table?
+	bool batch=false; // Should we also time the batch operations?
         int n=-1;
 
         fprintf(stderr,NAME " " VERSION " (" VERSION_DATE ")\n");
@@ -759,6 +1168,9 @@ int main(int argc,char **argv)
 			case 't':
 				machine_table=true;
 				break;
+			case 'b':
+				batch=true;
+				break;
 			default:
 				fprintf(stderr,"%s: Bad switch: %s.\n",
 					argv[0],s);
@@ -772,10 +1184,12 @@ int main(int argc,char **argv)
 	}
 
         if (n<0) {
-                fprintf(stderr,"Usage:\n\t%s [-n] [-t] n\n"
+                fprintf(stderr,"Usage:\n\t%s [-n] [-t] [-b] n\n"
 			"\twhere n is an integer from 1 to %d.\n\n"
 			"\tUse -n (no-test) to skip the testing.\n"
-			"\tUse -t (table) to output a machine-readable table with the timings.\n",
+			"\tUse -t (table) to output a machine-readable table with the timings.\n"
+			"\tUse -b (batch) to also time table_insert_many() and\n"
+			"\ttable_lookup_many(), as tests 6-9 of the table.\n",
 			argv[0],TABLESIZE);
 		exit(EXIT_FAILURE);
 	}
@@ -790,7 +1204,7 @@ int main(int argc,char **argv)
 		printf("All correctness tests succeeded!\n\n");
 	}
         /*getchar();*/
-        speed_test(n,machine_table);
+        speed_test(n,machine_table,batch);
         if (!machine_table) {
 		printf("Test completed.\n");
 	}
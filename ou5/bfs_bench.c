@@ -0,0 +1,295 @@
+#define _POSIX_C_SOURCE 200112L	// For clock_gettime().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "csr.h"
+#include "dobfs.h"
+
+/*
+ * Benchmark driver for the direction-optimizing breadth-first search of
+ * OU5, see dobfs.h. A synthetic graph with a power-law degree distribution
+ * is generated with the R-MAT method (as in the Graph500 benchmark), with
+ * 2^scale nodes and edgefactor * 2^scale edges. From a number of random
+ * source nodes, a plain queue-based search, dobfs() with one thread and
+ * dobfs() with the given number of threads are timed. The levels found by
+ * dobfs() are checked against the plain search.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+// R-MAT probabilities of the four quadrants, the last one is 1-A-B-C.
+#define RMAT_A 0.57
+#define RMAT_B 0.19
+#define RMAT_C 0.19
+
+#define DEFAULT_SCALE 20
+#define DEFAULT_EDGEFACTOR 16
+#define DEFAULT_THREADS 4
+#define MAX_THREADS 64
+#define DEFAULT_RUNS 8
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * next_random() - Draw a pseudo-random number (xorshift64*).
+ * @state: Pointer to the state of the generator, not zero.
+ *
+ * Returns: A pseudo-random 64-bit number.
+ */
+static uint64_t next_random(uint64_t *state)
+{
+	uint64_t x = *state;
+	x ^= x >> 12;
+	x ^= x << 25;
+	x ^= x >> 27;
+	*state = x;
+	return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * next_uniform() - Draw a pseudo-random number in [0, 1).
+ * @state: Pointer to the state of the generator.
+ *
+ * Returns: A pseudo-random number in [0, 1).
+ */
+static double next_uniform(uint64_t *state)
+{
+	return (next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * generate_rmat() - Generate the edges of an R-MAT graph.
+ * @scale: Two-logarithm of the number of nodes.
+ * @nr_of_edges: Number of edges to generate.
+ * @src: Array where the source node of each edge is stored.
+ * @dst: Array where the destination node of each edge is stored.
+ * @seed: Seed of the random generator, not zero.
+ *
+ * Each edge picks one quadrant of the adjacency matrix per bit of the node
+ * numbers. The node numbers are then shuffled, so that the high-degree
+ * nodes are not all at the start of the arrays.
+ *
+ * Returns: Nothing.
+ */
+static void generate_rmat(int scale, int nr_of_edges, int *src, int *dst,
+			  uint64_t seed)
+{
+	uint64_t state = seed;
+	int n = 1 << scale;
+
+	for (int i = 0; i < nr_of_edges; i++) {
+		int s = 0;
+		int d = 0;
+		for (int bit = 0; bit < scale; bit++) {
+			double r = next_uniform(&state);
+			s <<= 1;
+			d <<= 1;
+			if (r < RMAT_A) {
+				// Top left quadrant.
+			} else if (r < RMAT_A + RMAT_B) {
+				d |= 1;
+			} else if (r < RMAT_A + RMAT_B + RMAT_C) {
+				s |= 1;
+			} else {
+				s |= 1;
+				d |= 1;
+			}
+		}
+		src[i] = s;
+		dst[i] = d;
+	}
+
+	// Shuffle the node numbers (Fisher-Yates).
+	int *perm = malloc(n * sizeof(int));
+	for (int v = 0; v < n; v++) {
+		perm[v] = v;
+	}
+	for (int v = n - 1; v > 0; v--) {
+		int j = next_random(&state) % (v + 1);
+		int tmp = perm[v];
+		perm[v] = perm[j];
+		perm[j] = tmp;
+	}
+	for (int i = 0; i < nr_of_edges; i++) {
+		src[i] = perm[src[i]];
+		dst[i] = perm[dst[i]];
+	}
+	free(perm);
+}
+
+/**
+ * plain_bfs() - Queue-based breadth-first search, for reference.
+ * @c: CSR structure with the out-edges of the graph.
+ * @src: Source node number.
+ * @level: Array where the level of each node is stored, -1 if not reached.
+ * @queue: Array of at least nr_of_nodes elements.
+ *
+ * Returns: The number of edges looked at.
+ */
+static long plain_bfs(const csr *c, int src, int *level, int *queue)
+{
+	int head = 0;
+	int tail = 0;
+	long edges_checked = 0;
+
+	for (int v = 0; v < c->nr_of_nodes; v++) {
+		level[v] = -1;
+	}
+	level[src] = 0;
+	queue[tail++] = src;
+	while (head < tail) {
+		int v = queue[head++];
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			edges_checked++;
+			if (level[w] < 0) {
+				level[w] = level[v] + 1;
+				queue[tail++] = w;
+			}
+		}
+	}
+	return edges_checked;
+}
+
+/**
+ * seconds() - Read a monotonic clock.
+ *
+ * Returns: The time in seconds since an arbitrary starting point.
+ */
+static double seconds(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * print_usage() - Print the command line syntax to stderr.
+ * @name: Name of the program.
+ *
+ * Returns: Nothing.
+ */
+static void print_usage(const char *name)
+{
+	fprintf(stderr, "Useage: %s [-s scale] [-e edgefactor] [-t threads] "
+			"[-r runs]\n"
+			"\tGenerates an R-MAT graph with 2^scale nodes "
+			"(default %d) and\n\tedgefactor*2^scale edges "
+			"(default %d), and times %d searches (-r)\n\twith "
+			"%d threads (-t, at most %d).\n", name, DEFAULT_SCALE,
+			DEFAULT_EDGEFACTOR, DEFAULT_RUNS, DEFAULT_THREADS,
+			MAX_THREADS);
+}
+
+int main(int argc, char **argv)
+{
+	int scale = DEFAULT_SCALE;
+	int edgefactor = DEFAULT_EDGEFACTOR;
+	int nr_of_threads = DEFAULT_THREADS;
+	int runs = DEFAULT_RUNS;
+
+	// Parse the options.
+	for (int argi = 1; argi < argc; argi++) {
+		if (argi + 1 >= argc) {
+			print_usage(argv[0]);
+			return -1;
+		}
+		int value = atoi(argv[argi + 1]);
+		if (strcmp(argv[argi], "-s") == 0 && value > 0 && value < 28) {
+			scale = value;
+		} else if (strcmp(argv[argi], "-e") == 0 && value > 0) {
+			edgefactor = value;
+		} else if (strcmp(argv[argi], "-t") == 0 && value > 0
+			   && value <= MAX_THREADS) {
+			nr_of_threads = value;
+		} else if (strcmp(argv[argi], "-r") == 0 && value > 0) {
+			runs = value;
+		} else {
+			print_usage(argv[0]);
+			return -1;
+		}
+		argi++;
+	}
+	int n = 1 << scale;
+	if ((long)edgefactor * n > 1L << 30) {
+		fprintf(stderr, "FAIL: Too many edges.\n");
+		return -1;
+	}
+	int m = edgefactor * n;
+
+	// Generate the graph and pack it in both directions.
+	double t0 = seconds();
+	int *src = malloc(m * sizeof(int));
+	int *dst = malloc(m * sizeof(int));
+	generate_rmat(scale, m, src, dst, 0x9E3779B97F4A7C15ULL);
+	csr *out = csr_build(n, m, src, dst);
+	csr *in = csr_build(n, m, dst, src);
+	free(src);
+	free(dst);
+	printf("Graph: %d nodes, %d edges, built in %.2f s.\n", n, m,
+	       seconds() - t0);
+
+	int *level = malloc(n * sizeof(int));
+	int *expected = malloc(n * sizeof(int));
+	int *queue = malloc(n * sizeof(int));
+	uint64_t state = 12345;
+	double total[3] = {0, 0, 0};
+	long total_edges = 0;
+	bool ok = true;
+
+	printf("%8s %9s %6s %4s %10s %10s %10s\n", "source", "reached",
+	       "levels", "bu", "plain (s)", "1 thr (s)", "n thr (s)");
+	for (int r = 0; r < runs; r++) {
+		// Random source node with at least one out-edge.
+		int s;
+		do {
+			s = next_random(&state) % n;
+		} while (csr_degree(out, s) == 0);
+
+		t0 = seconds();
+		long edges = plain_bfs(out, s, expected, queue);
+		double t_plain = seconds() - t0;
+
+		t0 = seconds();
+		dobfs(out, in, s, 1, level, NULL);
+		double t_one = seconds() - t0;
+		ok = ok && memcmp(level, expected, n * sizeof(int)) == 0;
+
+		struct dobfs_stats stats;
+		t0 = seconds();
+		int reached = dobfs(out, in, s, nr_of_threads, level, &stats);
+		double t_many = seconds() - t0;
+		ok = ok && memcmp(level, expected, n * sizeof(int)) == 0;
+
+		printf("%8d %9d %6d %4d %10.4f %10.4f %10.4f\n", s, reached,
+		       stats.nr_of_levels, stats.nr_of_bottom_up, t_plain,
+		       t_one, t_many);
+		total[0] += t_plain;
+		total[1] += t_one;
+		total[2] += t_many;
+		total_edges += edges;
+	}
+	printf("Million edges per second: plain %.1f, 1 thread %.1f, "
+	       "%d threads %.1f\n", total_edges / total[0] * 1e-6,
+	       total_edges / total[1] * 1e-6, nr_of_threads,
+	       total_edges / total[2] * 1e-6);
+	printf(ok ? "All levels are identical.\n"
+	       : "FAIL: Levels differ from the plain search.\n");
+
+	free(level);
+	free(expected);
+	free(queue);
+	csr_kill(out);
+	csr_kill(in);
+	return ok ? 0 : 1;
+}
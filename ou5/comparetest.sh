@@ -0,0 +1,137 @@
+#!/bin/bash
+#
+# Verify that the bidirectional search (is_connected -b), the SCC index
+# (is_connected -s), the query cache (is_connected -c) and the removal of
+# repeated edges (is_connected -d) give the same answers as the one-sided
+# breadth-first search, also in batch mode (is_connected -q) with one or
+# several threads (is_connected -j). Printing the shortest paths
+# (is_connected -p and -w) must not change the answers, and neither must
+# loading the map from a binary image made by map2bin. For each map in
+# maps/, all modes are run on the map's own input file and on a question
+# for every ordered pair of nodes in the map. Maps with a -w-output.txt
+# file must also give exactly that output with is_connected -w, with and
+# without -d and from the binary image, which checks the edge weights.
+# An image with a node id out of range in its label order or its edge
+# targets must be rejected when loaded.
+# Run from the ou5 directory after make.
+#
+# Useage: ./comparetest.sh
+
+status=0;
+
+# Removes the path printed after a positive answer.
+strip_path='s/^\(.*There is a path from [^ ]* to [^ ]*\):.*$/\1./';
+
+for map in maps/*.map;
+do
+input=${map%.map}-input.txt;
+pairs=$(mktemp);
+image=$(mktemp);
+
+# Every ordered pair of node labels in the map, followed by quit.
+grep -v '^[[:space:]]*#' $map | awk 'NF >= 2 {print $1; print $2}' \
+	| sort -u > ${pairs}.labels;
+awk 'NR == FNR {a[n++] = $1; next}
+     END {for (i = 0; i < n; i++) for (j = 0; j < n; j++) print a[i], a[j]}' \
+	${pairs}.labels /dev/null > $pairs;
+echo quit >> $pairs;
+
+# Maps that cannot be loaded give no image.
+if ! ./map2bin $map $image 2> /dev/null; then
+	rm -f $image;
+fi
+
+for questions in $input $pairs;
+do
+if [ -f $questions ]; then
+	for mode in -b -s -c "-c -s" -d "-d -b";
+	do
+	if ! cmp -s <(./is_connected $map < $questions 2>&1) \
+		    <(./is_connected $mode $map < $questions 2>&1); then
+		echo "FAIL: $map ($questions, $mode)";
+		status=1;
+	fi
+	done
+	# The same answers with the paths removed.
+	for mode in -p -w "-w -d";
+	do
+	if ! cmp -s <(./is_connected $map < $questions 2>&1) \
+		    <(./is_connected $mode $map < $questions 2>&1 \
+			| sed "$strip_path"); then
+		echo "FAIL: $map ($questions, $mode)";
+		status=1;
+	fi
+	done
+	# Batch mode prints the same answers without prompts.
+	for mode in "" -s "-j 4" "-s -j 4" "-p -j 4" -w;
+	do
+	if ! cmp -s <(./is_connected $map < $questions 2>&1 \
+			| sed 's/^Enter origin and destination (quit to exit): //' \
+			| grep -v -e '^$' -e '^Normal exit' -e '^Could not') \
+		    <(./is_connected $mode -q $questions $map 2>&1 \
+			| sed "$strip_path"); then
+		echo "FAIL: $map ($questions, $mode -q)";
+		status=1;
+	fi
+	done
+	# The binary image gives the same output, paths included.
+	for mode in "" -s -d -p -w "-q $questions";
+	do
+	if [ -f $image ] \
+	   && ! cmp -s <(./is_connected $mode $map < $questions 2>&1) \
+		       <(./is_connected $mode $image < $questions 2>&1); then
+		echo "FAIL: $map ($questions, $mode, image)";
+		status=1;
+	fi
+	done
+fi
+done
+
+# The cheapest paths are known for maps with an expected output.
+expected=${map%.map}-w-output.txt;
+if [ -f $expected ]; then
+	for mode in -w "-w -d";
+	do
+	if ! cmp -s $expected <(./is_connected $mode $map < $input 2>&1); then
+		echo "FAIL: $map ($input, $mode, expected output)";
+		status=1;
+	fi
+	done
+	if [ -f $image ] \
+	   && ! cmp -s $expected <(./is_connected -w $image < $input 2>&1); then
+		echo "FAIL: $map ($input, -w, image, expected output)";
+		status=1;
+	fi
+fi
+
+# Corrupt one node id in a section of the image, given by the offset of
+# the section in the header, and check that loading fails.
+if [ -f $image ]; then
+	nodes=$(od -An -t d4 -j 24 -N 4 $image | tr -d ' ');
+	edges=$(od -An -t d4 -j 28 -N 4 $image | tr -d ' ');
+	for section in 56 72;
+	do
+	if [ $section -eq 56 -a $nodes -eq 0 ] \
+	   || [ $section -eq 72 -a $edges -eq 0 ]; then
+		continue;
+	fi
+	at=$(od -An -t u8 -j $section -N 8 $image | tr -d ' ');
+	cp $image ${image}.bad;
+	printf '\377\377\377\177' \
+		| dd of=${image}.bad bs=1 seek=$at conv=notrunc 2> /dev/null;
+	if ! ./is_connected ${image}.bad < /dev/null 2>&1 \
+		| grep -q '^FAIL: Could not load the graph image'; then
+		echo "FAIL: $map (corrupted image, section at $section)";
+		status=1;
+	fi
+	done
+	rm -f ${image}.bad;
+fi
+rm -f $pairs ${pairs}.labels $image;
+echo "Compared $map";
+done
+
+if [ $status -eq 0 ]; then
+	echo "All answers are identical.";
+fi
+exit $status;
@@ -0,0 +1,136 @@
+#include <stdlib.h>
+
+#include "csr.h"
+
+/*
+ * Implementation of the compressed sparse row (CSR) adjacency structure for
+ * OU5, see csr.h.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Added edge weights, see csr_build_weighted().
+ *   v1.2  2026-10-17: Added csr_wrap().
+ */
+
+// =================== CSR STRUCTURE INTERFACE ======================
+
+/**
+ * csr_build() - Create a CSR structure from a list of edges.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @src: Array with the source node of each edge.
+ * @dst: Array with the destination node of each edge.
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_build(int nr_of_nodes, int nr_of_edges, const int *src,
+	       const int *dst)
+{
+	return csr_build_weighted(nr_of_nodes, nr_of_edges, src, dst, NULL);
+}
+
+/**
+ * csr_build_weighted() - Create a CSR structure from a list of weighted 
+ * 			  edges.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @src: Array with the source node of each edge.
+ * @dst: Array with the destination node of each edge.
+ * @weight: Array with the weight of each edge, or NULL.
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_build_weighted(int nr_of_nodes, int nr_of_edges, const int *src,
+			const int *dst, const double *weight)
+{
+	csr *c = malloc(sizeof(csr));
+	c->nr_of_nodes = nr_of_nodes;
+	c->nr_of_edges = nr_of_edges;
+	c->offsets = calloc(nr_of_nodes + 1, sizeof(int));
+	c->targets = malloc((nr_of_edges > 0 ? nr_of_edges : 1) * sizeof(int));
+	c->weights = NULL;
+	c->owned = true;
+	if (weight != NULL) {
+		c->weights = malloc((nr_of_edges > 0 ? nr_of_edges : 1) 
+				    * sizeof(double));
+	}
+
+	// Count the edges leaving each node, shifted one step.
+	for (int e = 0; e < nr_of_edges; e++) {
+		c->offsets[src[e] + 1]++;
+	}
+	// Prefix sum gives the start of each node's range.
+	for (int v = 0; v < nr_of_nodes; v++) {
+		c->offsets[v + 1] += c->offsets[v];
+	}
+	/* Place each edge at the next free position of its source node. The
+	   positions are tracked in a copy of the offsets, which keeps the sort
+	   stable. */
+	int *next = malloc((nr_of_nodes + 1) * sizeof(int));
+	for (int v = 0; v <= nr_of_nodes; v++) {
+		next[v] = c->offsets[v];
+	}
+	for (int e = 0; e < nr_of_edges; e++) {
+		int i = next[src[e]]++;
+		c->targets[i] = dst[e];
+		if (weight != NULL) {
+			c->weights[i] = weight[e];
+		}
+	}
+	free(next);
+
+	return c;
+}
+
+/**
+ * csr_wrap() - Create a CSR structure around existing arrays.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @offsets: Array of nr_of_nodes+1 offsets.
+ * @targets: Array of nr_of_edges targets.
+ * @weights: Array of nr_of_edges weights, or NULL.
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_wrap(int nr_of_nodes, int nr_of_edges, int *offsets, int *targets,
+	      double *weights)
+{
+	csr *c = malloc(sizeof(csr));
+	c->nr_of_nodes = nr_of_nodes;
+	c->nr_of_edges = nr_of_edges;
+	c->offsets = offsets;
+	c->targets = targets;
+	c->weights = weights;
+	c->owned = false;
+	return c;
+}
+
+/**
+ * csr_degree() - Return the out-degree of a node.
+ * @c: CSR structure to inspect.
+ * @v: Node number.
+ *
+ * Returns: The number of edges leaving node v.
+ */
+int csr_degree(const csr *c, int v)
+{
+	return c->offsets[v + 1] - c->offsets[v];
+}
+
+/**
+ * csr_kill() - Destroy a CSR structure.
+ * @c: CSR structure to destroy.
+ *
+ * Returns: Nothing.
+ */
+void csr_kill(csr *c)
+{
+	if (c->owned) {
+		free(c->offsets);
+		free(c->targets);
+		free(c->weights);
+	}
+	free(c);
+}
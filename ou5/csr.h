@@ -0,0 +1,111 @@
+#ifndef __CSR_H
+#define __CSR_H
+
+#include <stdbool.h>
+
+/*
+ * Compressed sparse row (CSR) adjacency structure for OU5. The nodes of a
+ * directed graph are numbered 0, ..., nr_of_nodes-1 and all edges are packed
+ * into two arrays. The targets of the edges leaving node v are stored in
+ * targets[offsets[v]], ..., targets[offsets[v+1]-1]. The structure is built
+ * once from an edge list and is not modified afterwards. After use, the
+ * function csr_kill() must be called to de-allocate the dynamic memory used
+ * by the structure.
+ *
+ * The edges may carry weights, stored in weights[offsets[v]], ...,
+ * weights[offsets[v+1]-1] next to the targets. Unweighted structures have
+ * weights set to NULL.
+ *
+ * A structure made by csr_wrap() uses arrays owned by someone else, e.g. a
+ * mapped file, and csr_kill() leaves them alone.
+ *
+ * The fields are public so that traversal loops can index the arrays
+ * directly. They must not be modified by the user.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Added edge weights, see csr_build_weighted().
+ *   v1.2  2026-10-17: Added csr_wrap().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct csr {
+	int nr_of_nodes;
+	int nr_of_edges;
+	int *offsets;	// nr_of_nodes+1 elements.
+	int *targets;	// nr_of_edges elements.
+	double *weights;	// nr_of_edges elements, or NULL.
+	bool owned;	// False if the arrays belong to someone else.
+} csr;
+
+// =================== CSR STRUCTURE INTERFACE ======================
+
+/**
+ * csr_build() - Create a CSR structure from a list of edges.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @src: Array with the source node of each edge.
+ * @dst: Array with the destination node of each edge.
+ *
+ * The edges are sorted by source node with a counting sort. The edges
+ * leaving a node keep the order they have in the edge list.
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_build(int nr_of_nodes, int nr_of_edges, const int *src,
+	       const int *dst);
+
+/**
+ * csr_build_weighted() - Create a CSR structure from a list of weighted 
+ * 			  edges.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @src: Array with the source node of each edge.
+ * @dst: Array with the destination node of each edge.
+ * @weight: Array with the weight of each edge, or NULL for an unweighted
+ * 	    structure.
+ *
+ * Same as csr_build(), but the weights are moved along with the targets.
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_build_weighted(int nr_of_nodes, int nr_of_edges, const int *src,
+			const int *dst, const double *weight);
+
+/**
+ * csr_wrap() - Create a CSR structure around existing arrays.
+ * @nr_of_nodes: Number of nodes in the graph.
+ * @nr_of_edges: Number of edges in the graph.
+ * @offsets: Array of nr_of_nodes+1 offsets.
+ * @targets: Array of nr_of_edges targets.
+ * @weights: Array of nr_of_edges weights, or NULL.
+ *
+ * The arrays are not copied. They must stay valid until the structure is 
+ * destroyed, and are not freed by csr_kill().
+ *
+ * Returns: A pointer to the new CSR structure.
+ */
+csr *csr_wrap(int nr_of_nodes, int nr_of_edges, int *offsets, int *targets,
+	      double *weights);
+
+/**
+ * csr_degree() - Return the out-degree of a node.
+ * @c: CSR structure to inspect.
+ * @v: Node number.
+ *
+ * Returns: The number of edges leaving node v.
+ */
+int csr_degree(const csr *c, int v);
+
+/**
+ * csr_kill() - Destroy a CSR structure.
+ * @c: CSR structure to destroy.
+ *
+ * Returns: Nothing.
+ */
+void csr_kill(csr *c);
+
+#endif
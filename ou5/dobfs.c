@@ -0,0 +1,352 @@
+#define _POSIX_C_SOURCE 200112L	// For pthread_barrier_t.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "dobfs.h"
+
+/*
+ * Implementation of the direction-optimizing breadth-first search for OU5,
+ * see dobfs.h. All threads run the same loop, one level per turn. Between
+ * two barriers, the threads expand the level by taking blocks of
+ * BLOCK_WORDS bitmap words from a shared counter. After the second barrier,
+ * the first thread (the caller) swaps the frontiers and picks the direction
+ * of the next level while the others wait at the first barrier.
+ *
+ * In a top-down level, several threads may reach the same node, so the seen
+ * and next bitmaps are updated with atomic operations and only the thread
+ * that sets the seen bit claims the node. In a bottom-up level, each thread
+ * only writes the words of its own blocks.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+// Number of bitmap words (64 nodes each) taken by a thread at a time.
+#define BLOCK_WORDS 16
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+struct worker;
+
+// State of a search, shared by all threads.
+struct search {
+	const csr *out;
+	const csr *in;
+	int *level;
+	int words;		// Number of words in each bitmap.
+	uint64_t *frontier;	// Nodes at the current level.
+	uint64_t *next;		// Nodes at the next level.
+	uint64_t *seen;		// Nodes at any level so far.
+	int depth;		// Number of the current level.
+	bool bottom_up;		// Direction of the current level.
+	bool done;
+	int next_block;		// First bitmap word not yet taken.
+	long unexplored_edges;	// Out-edges of the nodes not seen.
+	int nr_reached;
+	struct dobfs_stats stats;
+	struct worker *workers;
+	int nr_of_threads;
+	pthread_barrier_t barrier;
+};
+
+// State of one thread.
+struct worker {
+	struct search *s;
+	pthread_t thread;
+	int nr_found;		// Nodes added to the next level.
+	long found_edges;	// Out-edges of the nodes added.
+	long edges_checked;
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * take_block() - Take the next block of bitmap words to expand.
+ * @s: Search to take the block from.
+ * @first: Pointer to where the first word of the block is stored.
+ * @end: Pointer to where the word after the block is stored.
+ *
+ * Returns: True if a block was taken, false if all blocks are taken.
+ */
+static bool take_block(struct search *s, int *first, int *end)
+{
+	*first = __atomic_fetch_add(&s->next_block, BLOCK_WORDS,
+				    __ATOMIC_RELAXED);
+	if (*first >= s->words) {
+		return false;
+	}
+	*end = *first + BLOCK_WORDS;
+	if (*end > s->words) {
+		*end = s->words;
+	}
+	return true;
+}
+
+/**
+ * claim() - Mark a node as seen, unless another thread already has.
+ * @s: Search to manipulate.
+ * @u: Node number.
+ *
+ * Returns: True if this call marked the node, false if it was already seen.
+ */
+static bool claim(struct search *s, int u)
+{
+	uint64_t mask = (uint64_t)1 << (u % 64);
+	if (__atomic_load_n(&s->seen[u / 64], __ATOMIC_RELAXED) & mask) {
+		// Cheap test first, most edges lead to seen nodes.
+		return false;
+	}
+	uint64_t old = __atomic_fetch_or(&s->seen[u / 64], mask,
+					 __ATOMIC_RELAXED);
+	return (old & mask) == 0;
+}
+
+/**
+ * top_down() - Expand the frontier nodes in a block along their out-edges.
+ * @w: Thread state.
+ * @first: First bitmap word of the block.
+ * @end: Bitmap word after the block.
+ *
+ * Returns: Nothing.
+ */
+static void top_down(struct worker *w, int first, int end)
+{
+	struct search *s = w->s;
+	const csr *c = s->out;
+
+	for (int i = first; i < end; i++) {
+		uint64_t bits = s->frontier[i];
+		while (bits != 0) {
+			int v = i * 64 + __builtin_ctzll(bits);
+			bits &= bits - 1;
+			int last = c->offsets[v + 1];
+			for (int e = c->offsets[v]; e < last; e++) {
+				int u = c->targets[e];
+				w->edges_checked++;
+				if (!claim(s, u)) {
+					continue;
+				}
+				s->level[u] = s->depth + 1;
+				__atomic_fetch_or(&s->next[u / 64],
+						  (uint64_t)1 << (u % 64),
+						  __ATOMIC_RELAXED);
+				w->nr_found++;
+				w->found_edges += csr_degree(c, u);
+			}
+		}
+	}
+}
+
+/**
+ * bottom_up() - Look for a parent in the frontier for the unseen nodes in a
+ * 		 block.
+ * @w: Thread state.
+ * @first: First bitmap word of the block.
+ * @end: Bitmap word after the block.
+ *
+ * Returns: Nothing.
+ */
+static void bottom_up(struct worker *w, int first, int end)
+{
+	struct search *s = w->s;
+	const csr *c = s->in;
+	int n = c->nr_of_nodes;
+
+	for (int i = first; i < end; i++) {
+		uint64_t unseen = ~s->seen[i];
+		if (i == s->words - 1 && n % 64 != 0) {
+			// No nodes beyond the last one.
+			unseen &= ((uint64_t)1 << (n % 64)) - 1;
+		}
+		uint64_t found = 0;
+		while (unseen != 0) {
+			int b = __builtin_ctzll(unseen);
+			int v = i * 64 + b;
+			unseen &= unseen - 1;
+			int last = c->offsets[v + 1];
+			for (int e = c->offsets[v]; e < last; e++) {
+				int u = c->targets[e];
+				w->edges_checked++;
+				if ((s->frontier[u / 64] >> (u % 64)) & 1) {
+					// Found a parent, done with v.
+					s->level[v] = s->depth + 1;
+					found |= (uint64_t)1 << b;
+					w->nr_found++;
+					w->found_edges += csr_degree(s->out, v);
+					break;
+				}
+			}
+		}
+		s->seen[i] |= found;
+		s->next[i] = found;
+	}
+}
+
+/**
+ * finish_level() - Move on to the next level of a search.
+ * @s: Search to manipulate.
+ *
+ * Run by one thread while the others wait. Sums up the counts of the
+ * threads, makes the next level the current one and picks its direction.
+ *
+ * Returns: Nothing.
+ */
+static void finish_level(struct search *s)
+{
+	int nr_found = 0;
+	long found_edges = 0;
+	for (int t = 0; t < s->nr_of_threads; t++) {
+		nr_found += s->workers[t].nr_found;
+		found_edges += s->workers[t].found_edges;
+	}
+	s->stats.nr_of_levels++;
+	if (s->bottom_up) {
+		s->stats.nr_of_bottom_up++;
+	}
+	s->nr_reached += nr_found;
+	s->unexplored_edges -= found_edges;
+
+	uint64_t *tmp = s->frontier;
+	s->frontier = s->next;
+	s->next = tmp;
+	s->depth++;
+	s->next_block = 0;
+	s->done = nr_found == 0;
+
+	int n = s->out->nr_of_nodes;
+	if (!s->bottom_up
+	    && found_edges > s->unexplored_edges / DOBFS_ALPHA) {
+		s->bottom_up = true;
+	} else if (s->bottom_up && nr_found < n / DOBFS_BETA) {
+		s->bottom_up = false;
+	}
+	if (!s->bottom_up) {
+		// A bottom-up level overwrites every word of next by itself.
+		memset(s->next, 0, s->words * sizeof(uint64_t));
+	}
+}
+
+/**
+ * work() - Thread function that expands levels until the search is done.
+ * @arg: Pointer to the struct worker of the thread.
+ *
+ * Returns: NULL.
+ */
+static void *work(void *arg)
+{
+	struct worker *w = arg;
+	struct search *s = w->s;
+	int first;
+	int end;
+
+	while (true) {
+		pthread_barrier_wait(&s->barrier);
+		if (s->done) {
+			return NULL;
+		}
+		w->nr_found = 0;
+		w->found_edges = 0;
+		while (take_block(s, &first, &end)) {
+			if (s->bottom_up) {
+				bottom_up(w, first, end);
+			} else {
+				top_down(w, first, end);
+			}
+		}
+		pthread_barrier_wait(&s->barrier);
+		if (w == &s->workers[0]) {
+			finish_level(s);
+		}
+	}
+}
+
+// ===================== DOBFS INTERFACE ========================
+
+/**
+ * dobfs() - Breadth-first search from a node, direction-optimizing.
+ * @out: CSR structure with the out-edges of the graph.
+ * @in: CSR structure with the in-edges of the graph.
+ * @src: Source node number.
+ * @nr_of_threads: Number of threads to use, at least 1.
+ * @level: Array where the level of each node is stored, -1 if not reached.
+ * @stats: Pointer to where statistics about the search are stored, or NULL.
+ *
+ * Exits with an error message if a thread cannot be created.
+ *
+ * Returns: The number of nodes reached, including the source node.
+ */
+int dobfs(const csr *out, const csr *in, int src, int nr_of_threads,
+	  int *level, struct dobfs_stats *stats)
+{
+	int n = out->nr_of_nodes;
+	struct search s;
+	s.out = out;
+	s.in = in;
+	s.level = level;
+	s.words = (n + 63) / 64;
+	s.frontier = calloc(s.words > 0 ? s.words : 1, sizeof(uint64_t));
+	s.next = calloc(s.words > 0 ? s.words : 1, sizeof(uint64_t));
+	s.seen = calloc(s.words > 0 ? s.words : 1, sizeof(uint64_t));
+	s.depth = 0;
+	s.bottom_up = false;
+	s.done = false;
+	s.next_block = 0;
+	s.unexplored_edges = out->nr_of_edges - csr_degree(out, src);
+	s.nr_reached = 1;
+	s.stats.nr_of_levels = 0;
+	s.stats.nr_of_bottom_up = 0;
+	s.stats.edges_checked = 0;
+	s.nr_of_threads = nr_of_threads;
+	s.workers = malloc(nr_of_threads * sizeof(struct worker));
+	pthread_barrier_init(&s.barrier, NULL, nr_of_threads);
+
+	for (int v = 0; v < n; v++) {
+		level[v] = -1;
+	}
+	level[src] = 0;
+	s.seen[src / 64] |= (uint64_t)1 << (src % 64);
+	s.frontier[src / 64] |= (uint64_t)1 << (src % 64);
+
+	for (int t = 0; t < nr_of_threads; t++) {
+		s.workers[t].s = &s;
+		s.workers[t].edges_checked = 0;
+	}
+	for (int t = 1; t < nr_of_threads; t++) {
+		// The barrier counts on every thread, so a missing thread 
+		// would leave the others waiting forever.
+		int err = pthread_create(&s.workers[t].thread, NULL, work,
+					 &s.workers[t]);
+		if (err != 0) {
+			fprintf(stderr, "FAIL: Could not create thread: %s\n",
+				strerror(err));
+			exit(EXIT_FAILURE);
+		}
+	}
+	work(&s.workers[0]);
+	for (int t = 1; t < nr_of_threads; t++) {
+		pthread_join(s.workers[t].thread, NULL);
+	}
+
+	for (int t = 0; t < nr_of_threads; t++) {
+		s.stats.edges_checked += s.workers[t].edges_checked;
+	}
+	if (stats != NULL) {
+		*stats = s.stats;
+	}
+	pthread_barrier_destroy(&s.barrier);
+	free(s.workers);
+	free(s.frontier);
+	free(s.next);
+	free(s.seen);
+
+	return s.nr_reached;
+}
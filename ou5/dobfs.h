@@ -0,0 +1,67 @@
+#ifndef __DOBFS_H
+#define __DOBFS_H
+
+#include "csr.h"
+
+/*
+ * Direction-optimizing breadth-first search for OU5. The search runs level
+ * by level over the CSR representation of a graph, with the current and the
+ * next frontier stored as bitmaps with one bit per node. Each level is
+ * expanded in one of two directions:
+ *
+ *   - Top-down: every node in the frontier checks its out-edges and claims
+ *     the targets that have not been seen. Cheap while the frontier is small.
+ *   - Bottom-up: every node that has not been seen checks its in-edges and
+ *     stops at the first one that comes from the frontier. Cheap when the
+ *     frontier is large, which is common for a few levels in graphs with a
+ *     power-law degree distribution.
+ *
+ * The search switches to bottom-up when the edges leaving the frontier
+ * outnumber the edges of the unseen nodes divided by DOBFS_ALPHA, and back
+ * to top-down when the frontier holds less than nr_of_nodes/DOBFS_BETA
+ * nodes. Each level is shared between a number of threads that take blocks
+ * of the bitmaps from a common counter.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ====================== PUBLIC CONSTANTS ==========================
+
+#define DOBFS_ALPHA 14
+#define DOBFS_BETA 24
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+// Statistics from a search.
+struct dobfs_stats {
+	int nr_of_levels;	// Number of levels expanded.
+	int nr_of_bottom_up;	// Number of levels expanded bottom-up.
+	long edges_checked;	// Number of edges looked at.
+};
+
+// ===================== DOBFS INTERFACE ========================
+
+/**
+ * dobfs() - Breadth-first search from a node, direction-optimizing.
+ * @out: CSR structure with the out-edges of the graph.
+ * @in: CSR structure with the in-edges of the graph, e.g. from
+ * 	graph_csr_in().
+ * @src: Source node number.
+ * @nr_of_threads: Number of threads to use, at least 1. The calling thread
+ * 		   is one of them.
+ * @level: Array of at least nr_of_nodes elements. Afterwards, level[v] is
+ * 	   the number of edges on a shortest path from src to v, or -1 if
+ * 	   there is no path.
+ * @stats: Pointer to where statistics about the search are stored, or NULL.
+ *
+ * Exits with an error message if a thread cannot be created.
+ *
+ * Returns: The number of nodes reached, including the source node.
+ */
+int dobfs(const csr *out, const csr *in, int src, int nr_of_threads,
+	  int *level, struct dobfs_stats *stats);
+
+#endif
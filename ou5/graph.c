@@ -1,23 +1,71 @@
+#define _POSIX_C_SOURCE 200112L	// For mmap().
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "graph.h"
-#include "array_1d.h"
 #include "dlist.h"
+#include "hashtable.h"
+#include "csr.h"
 
 /*
  * Implementation of a generic graph for the "Datastructures and algorithms" 
  * course at the Department of Computing Science, Umea University. The graph 
  * stores nodes and edges of a directed or undirected graph. The graph is 
- * constructed using an array to contain all the nodes, and a directed list for 
- * each node containing that node's immediate neighbours. The node labels may 
- * only be of string type. After use, the function graph_kill() must be called 
- * to free the dynamic memory used by the graph itself. At node insertion, a 
+ * constructed using an array to contain all the nodes, and a growing array 
+ * for each node containing the ids of that node's immediate neighbours, so 
+ * each label is stored once, in its node. The neighbours can be visited 
+ * without any copying through the neighbour iterator, see 
+ * graph_neighbour_iter_begin(). The node labels may only be of string type.
+ * After use, the function graph_kill() must be called to free the dynamic
+ * memory used by the graph itself. At node insertion, a 
  * dynamic copy of the node label is made and inserted into the graph, which 
  * consequently also will be de-allocated when the graph is destroyed through 
- * graph_kill(). 
+ * graph_kill(). The graph also keeps a hash table index from node label to
+ * node, so nodes are found by label in constant expected time. Each node has
+ * a dense integer id, its position in the node_array. The function 
+ * graph_freeze() packs all edges into a CSR structure indexed by node id, 
+ * together with a reverse CSR structure holding the in-edges of each node.
+ * Both are dropped as soon as the graph is modified again.
+ *
+ * A graph can keep an index of its edges, turned on by graph_unique_edges().
+ * The index is a hash table from the (source id, destination id) pair of 
+ * each edge to the position of the destination id in the neighbour array of
+ * the source node. It makes duplicate checks in graph_insert_edge() and 
+ * graph_delete_edge() run in constant expected time.
+ *
+ * Edges may carry weights. As long as all edges have weight 1, no weights 
+ * are stored. The first edge with another weight gives every node an array 
+ * of weights next to its array of neighbours, and graph_freeze() then also 
+ * packs the weights into the CSR structure.
+ *
+ * A frozen graph can be saved as a binary image by graph_save_binary(): a
+ * header, the labels as a string table, the node ids sorted by label and 
+ * the arrays of both CSR structures, each section aligned to 8 bytes. 
+ * graph_load_binary() maps the image and points the graph into it. The 
+ * labels, the neighbour arrays and the CSR structures stay in the image, 
+ * and all nodes are allocated as one block. Until a node is inserted, 
+ * nodes are found by binary search over the sorted ids instead of through
+ * the label index. The mapping is private and writable, so edges can be 
+ * deleted in place, and an array in the image is copied to the heap when
+ * it has to grow.
+ *
+ * The seen status of a node is an epoch stamp: a node is seen if its stamp
+ * equals the current epoch. graph_reset_seen() starts a new epoch instead of
+ * visiting all nodes. Independent traversals can keep their own seen status
+ * in a graph_visit object, indexed by node id. The seen status used by the
+ * graph_node_*_seen() functions is a graph_visit object owned by the graph,
+ * so struct node holds no traversal state and a graph that is not modified
+ * can be traversed by several threads at once, each with its own visit
+ * object.
  * 
  * Note: Only the functions neccessary to complete the task of OU5 has been 
  * implemented. Thus not all functions seen in the header file "graph.h" has 
@@ -31,18 +79,101 @@
  *   v1.0  2020-06-05: First public version.
  *   v2.0  2020-06-13: Fixed bug where the code would traverse out of the valid
  * 		       range of the node_array if the array was fully populated.
+ *   v2.1  2026-10-17: Added a hash table index from label to node. Node
+ * 		       lookup and node/edge insertion no longer scan the
+ * 		       node_array.
+ *   v2.2  2026-10-17: Added integer node ids and graph_freeze(), which
+ * 		       builds a CSR representation of the edges.
+ *   v2.3  2026-10-17: The neighbour lists hold node pointers instead of
+ * 		       label copies. Added the neighbour iterator.
+ *   v2.4  2026-10-17: Seen status kept as epoch stamps, graph_reset_seen()
+ * 		       is O(1). Added the graph_visit object.
+ *   v2.5  2026-10-17: graph_freeze() also builds the reverse adjacency.
+ *   v2.6  2026-10-17: Added graph_version().
+ *   v2.7  2026-10-17: Seen status moved out of struct node into a visit
+ * 		       object owned by the graph.
+ *   v2.8  2026-10-17: Added graph_intern_node(). graph_insert_edge() checks
+ * 		       the nodes by id instead of by label.
+ *   v2.9  2026-10-17: The neighbours of a node are kept in an array of
+ * 		       node ids instead of a dlist of node pointers.
+ *   v3.0  2026-10-17: Added the edge index, see graph_unique_edges(), and
+ * 		       graph_delete_edge().
+ *   v3.1  2026-10-17: The node_array is a plain array that grows by 
+ * 		       doubling. Added graph_reserve().
+ *   v3.2  2026-10-17: Added edge weights, see 
+ * 		       graph_insert_weighted_edge().
+ *   v3.3  2026-10-17: Added graph_save_binary() and graph_load_binary().
+ * 		       The label index is built at the first node insertion.
  */
 
 // ====================== PUBLIC DATA TYPES ==========================
 
 struct node {
+	int id;
 	char *label;
-	bool is_seen;
-	dlist *neighbours;
+	int *neighbours;	// Ids of the neighbour nodes.
+	double *weights;	// Weights of the edges, or NULL.
+	int nr_of_neighbours;
+	int capacity;		// Number of ids that fit in neighbours.
 }; 
 
+struct graph_visit {
+	int nr_of_nodes;
+	unsigned int epoch;
+	unsigned int *stamps;
+};
+
 struct graph {
-	array_1d *node_array;
+	node **node_array;	// Node with id i at position i.
+	int capacity;		// Number of nodes that fit in node_array.
+	table *label_index;	// Label to node, or NULL.
+	const int *label_order;	// Node ids sorted by label, or NULL.
+	int nr_of_nodes;
+	int nr_of_edges;
+	csr *frozen;
+	csr *frozen_in;
+	graph_visit seen;	// Seen status of the graph_node_*_seen() API.
+	unsigned long version;
+	table *edge_index;	// Edge to struct edge_entry, or NULL.
+	bool weighted;		// True if the nodes have weight arrays.
+	char *image;		// Mapped binary image, or NULL.
+	size_t image_size;
+	node *node_block;	// Nodes allocated as one block, or NULL.
+	int nr_in_block;
+};
+
+// An edge in the edge index.
+struct edge_entry {
+	uint64_t key;	// Source id in the high bits, destination id low.
+	int pos;	// Position in the neighbour array of the source node.
+};
+
+// ==================== BINARY IMAGE FORMAT ===========================
+
+#define IMAGE_MAGIC "OU5GRAPH"
+#define IMAGE_VERSION 1
+#define IMAGE_BYTE_ORDER 0x01020304	// Tells the byte order of the host.
+#define IMAGE_WEIGHTED 1		// Flag set if the weights are stored.
+
+/* Header at the start of a binary image. The sections are given as byte 
+   offsets from the start of the image. */
+struct image_header {
+	char magic[8];		// IMAGE_MAGIC, without the terminating 0.
+	uint32_t version;	// IMAGE_VERSION.
+	uint32_t byte_order;	// IMAGE_BYTE_ORDER as written by the host.
+	uint32_t int_size;	// sizeof(int) of the host.
+	uint32_t flags;
+	int32_t nr_of_nodes;
+	int32_t nr_of_edges;
+	uint64_t size;		// Size of the whole image.
+	uint64_t labels;	// nr_of_nodes+1 string table offsets, uint64_t.
+	uint64_t strings;	// String table, the labels with a 0 after each.
+	uint64_t label_order;	// nr_of_nodes ids sorted by label, int.
+	uint64_t offsets;	// nr_of_nodes+1 offsets of the out-edges, int.
+	uint64_t targets;	// nr_of_edges targets of the out-edges, int.
+	uint64_t weights;	// nr_of_edges weights, double, or 0.
+	uint64_t offsets_in;	// nr_of_nodes+1 offsets of the in-edges, int.
+	uint64_t targets_in;	// nr_of_edges targets of the in-edges, int.
 };
 
 // ===================== INTERNAL FUNCTIONS ==========================
@@ -77,40 +208,451 @@ char *copy_string(const char *s)
 }
 
 /**
- * clone_dlist() - Create a dynamic copy of a dlist.
- * @l: pointer to dlist to clone.
+ * clone_labels() - Create a list of copies of the neighbour labels of a node.
+ * @g: Graph storing the node.
+ * @n: Node to copy the neighbour labels of.
  * 
- * Allocates memory and clones the contents of l into a new dynamic and directed 
- * list. The list must have strings as its elements.  
+ * Allocates memory and clones the labels of the neighbours of n into a new 
+ * dynamic and directed list.
  * 
- * Returns: Pointer to the copy of l. 
+ * Returns: Pointer to the list of label copies. 
  */
-dlist *clone_dlist(const dlist* l)
+static dlist *clone_labels(const graph *g, const node *n)
 {
 	// Create new and empty list.
 	dlist *new_list = dlist_empty(free);
-
-	// Get first position in each list.
-	dlist_pos p_old = dlist_first(l);
 	dlist_pos p_new = dlist_first(new_list);
 
-	while (!dlist_is_end(l, p_old)) {
-		// Fetch string from list
-		const char *str = dlist_inspect(l, p_old);
+	for (int i = 0; i < n->nr_of_neighbours; i++) {
+		// Fetch node label from the array.
+		const node *m = g->node_array[n->neighbours[i]];
 
-		// Create dyamic copy of the string.
-		char *str_cpy = copy_string(str);
-		
-		// Insert string into the new list.
+		// Create dyamic copy of the string and insert into the list.
+		char *str_cpy = copy_string(m->label);
 		p_new = dlist_insert(new_list, str_cpy, p_new);
-
-		// Traverse the lists.
-		p_old = dlist_next(l, p_old);
 		p_new = dlist_next(new_list, p_new);
 	}
 	return new_list; 
 }
 
+/**
+ * compare_labels() - Compare two node labels.
+ * @s1: Pointer to label 1.
+ * @s2: Pointer to label 2.
+ *
+ * Compare function for the label index, see util.h.
+ *
+ * Returns: Negative, zero or positive value as for strcmp().
+ */
+static int compare_labels(const void *s1, const void *s2)
+{
+	return strcmp(s1, s2);
+}
+
+/**
+ * edge_key() - Combine the ids of the end nodes of an edge into one key.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ *
+ * Returns: The key of the edge.
+ */
+static uint64_t edge_key(int src, int dst)
+{
+	return ((uint64_t)(uint32_t)src << 32) | (uint32_t)dst;
+}
+
+/**
+ * compare_edge_keys() - Compare two edge keys.
+ * @k1: Pointer to key 1.
+ * @k2: Pointer to key 2.
+ *
+ * Compare function for the edge index, see util.h.
+ *
+ * Returns: Negative, zero or positive value if k1 is smaller than, equal to
+ * 	    or larger than k2.
+ */
+static int compare_edge_keys(const void *k1, const void *k2)
+{
+	uint64_t a = *(const uint64_t *)k1;
+	uint64_t b = *(const uint64_t *)k2;
+	return (a > b) - (a < b);
+}
+
+/**
+ * find_edge() - Look up an edge in the edge index.
+ * @g: Graph with an edge index.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ *
+ * Returns: The entry of the edge, or NULL if the edge is not in the graph.
+ */
+static struct edge_entry *find_edge(const graph *g, int src, int dst)
+{
+	uint64_t key = edge_key(src, dst);
+	return table_lookup(g->edge_index, &key);
+}
+
+/**
+ * index_edge() - Add an edge to the edge index.
+ * @g: Graph with an edge index.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @pos: Position of dst in the neighbour array of the source node.
+ *
+ * Returns: Nothing.
+ */
+static void index_edge(graph *g, int src, int dst, int pos)
+{
+	struct edge_entry *e = malloc(sizeof(struct edge_entry));
+	e->key = edge_key(src, dst);
+	e->pos = pos;
+	// The index refers to the key inside the entry.
+	table_insert(g->edge_index, &e->key, e);
+}
+
+/**
+ * add_weights() - Give every node of a graph an array of edge weights.
+ * @g: Graph to manipulate.
+ *
+ * All edges already in the graph get weight 1.
+ *
+ * Returns: Nothing.
+ */
+static void add_weights(graph *g)
+{
+	for (int i = 0; i < g->nr_of_nodes; i++) {
+		node *n = g->node_array[i];
+		n->weights = malloc((n->capacity > 0 ? n->capacity : 1) 
+				    * sizeof(double));
+		for (int j = 0; j < n->nr_of_neighbours; j++) {
+			n->weights[j] = 1.0;
+		}
+	}
+	g->weighted = true;
+}
+
+/**
+ * owned_node() - Check that a node belongs to a graph.
+ * @g: Graph to inspect.
+ * @n: Node to check.
+ *
+ * Returns: The node n if it is stored in g at the position of its id,
+ * 	    otherwise NULL.
+ */
+static node *owned_node(const graph *g, node *n)
+{
+	if (n->id < 0 || n->id >= g->nr_of_nodes
+	    || g->node_array[n->id] != n) {
+		return NULL;
+	}
+	return n;
+}
+
+/**
+ * visit_cover() - Make a visit object cover a number of nodes.
+ * @v: Visit object to manipulate.
+ * @n: Number of nodes to cover.
+ *
+ * The stamp array grows by doubling. New nodes are not seen.
+ *
+ * Returns: Nothing.
+ */
+static void visit_cover(graph_visit *v, int n)
+{
+	if (n <= v->nr_of_nodes) {
+		return;
+	}
+	int size = v->nr_of_nodes > 0 ? 2 * v->nr_of_nodes : 16;
+	if (size < n) {
+		size = n;
+	}
+	v->stamps = realloc(v->stamps, size * sizeof(unsigned int));
+	memset(&v->stamps[v->nr_of_nodes], 0,
+	       (size - v->nr_of_nodes) * sizeof(unsigned int));
+	v->nr_of_nodes = size;
+}
+
+/**
+ * thaw() - Drop the CSR representation of a graph that is being modified.
+ * @g: Graph to manipulate.
+ *
+ * Also bumps the version of the graph, see graph_version().
+ *
+ * Returns: Nothing.
+ */
+static void thaw(graph *g)
+{
+	// Any modification makes a new version of the graph.
+	g->version++;
+	if (g->frozen != NULL) {
+		csr_kill(g->frozen);
+		csr_kill(g->frozen_in);
+		g->frozen = NULL;
+		g->frozen_in = NULL;
+	}
+}
+
+/**
+ * in_image() - Check if memory lies in the binary image of a graph.
+ * @g: Graph to inspect.
+ * @p: Pointer to check.
+ *
+ * Returns: True if p points into the image that g was loaded from.
+ */
+static bool in_image(const graph *g, const void *p)
+{
+	const char *c = p;
+	return g->image != NULL && c >= g->image 
+		&& c < g->image + g->image_size;
+}
+
+/**
+ * resize() - Resize an array of a graph.
+ * @g: Graph storing the array.
+ * @p: Array to resize, or NULL.
+ * @used: Number of bytes in use.
+ * @size: New size in bytes.
+ *
+ * Same as realloc(), except that an array in the binary image is copied to
+ * the heap instead.
+ *
+ * Returns: A pointer to the resized array.
+ */
+static void *resize(const graph *g, void *p, size_t used, size_t size)
+{
+	if (!in_image(g, p)) {
+		return realloc(p, size);
+	}
+	void *q = malloc(size);
+	memcpy(q, p, used);
+	return q;
+}
+
+/**
+ * index_labels() - Make sure a graph has a label index.
+ * @g: Graph to manipulate.
+ *
+ * Builds the index from the nodes already in the graph, if there is none.
+ *
+ * Returns: Nothing.
+ */
+static void index_labels(graph *g)
+{
+	if (g->label_index != NULL) {
+		return;
+	}
+	/* The keys are the labels owned by the nodes, so the index frees 
+	   neither keys nor values. */
+	g->label_index = table_empty_hash(compare_labels, hash_string, NULL, 
+					  NULL);
+	for (int i = 0; i < g->nr_of_nodes; i++) {
+		node *n = g->node_array[i];
+		table_insert(g->label_index, n->label, n);
+	}
+	// New nodes would not be in the sorted order.
+	g->label_order = NULL;
+}
+
+/**
+ * find_in_order() - Find a node by binary search over the sorted ids.
+ * @g: Graph with label_order set.
+ * @s: Label to look for.
+ *
+ * Returns: A pointer to the node with label s, or NULL.
+ */
+static node *find_in_order(const graph *g, const char *s)
+{
+	int lo = 0;
+	int hi = g->nr_of_nodes;
+	while (lo < hi) {
+		int mid = lo + (hi - lo) / 2;
+		node *n = g->node_array[g->label_order[mid]];
+		int cmp = strcmp(s, n->label);
+		if (cmp == 0) {
+			return n;
+		} else if (cmp < 0) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * compare_node_labels() - Compare the labels of two nodes.
+ * @n1: Pointer to a pointer to node 1.
+ * @n2: Pointer to a pointer to node 2.
+ *
+ * Compare function for qsort() over an array of node pointers.
+ *
+ * Returns: Negative, zero or positive value as for strcmp().
+ */
+static int compare_node_labels(const void *n1, const void *n2)
+{
+	const node *a = *(node * const *)n1;
+	const node *b = *(node * const *)n2;
+	return strcmp(a->label, b->label);
+}
+
+/**
+ * align8() - Round a size up to a multiple of 8.
+ * @size: Size to round.
+ *
+ * Returns: The smallest multiple of 8 that is at least size.
+ */
+static uint64_t align8(uint64_t size)
+{
+	return (size + 7) & ~(uint64_t)7;
+}
+
+/**
+ * write_padding() - Pad a section of a binary image.
+ * @f: Stream to write to.
+ * @size: Number of bytes written to the section.
+ *
+ * Writes zeros up to the next multiple of 8 bytes.
+ *
+ * Returns: True if all bytes were written.
+ */
+static bool write_padding(FILE *f, uint64_t size)
+{
+	static const char zeros[8];
+	size_t pad = align8(size) - size;
+	return fwrite(zeros, 1, pad, f) == pad;
+}
+
+/**
+ * write_section() - Write a section of a binary image.
+ * @f: Stream to write to.
+ * @p: Contents of the section.
+ * @size: Size of the contents in bytes.
+ *
+ * The section is padded with zeros to a multiple of 8 bytes.
+ *
+ * Returns: True if all bytes were written.
+ */
+static bool write_section(FILE *f, const void *p, uint64_t size)
+{
+	if (size > 0 && fwrite(p, 1, size, f) != size) {
+		return false;
+	}
+	return write_padding(f, size);
+}
+
+/**
+ * valid_section() - Check that a section lies within a binary image.
+ * @h: Header of the image.
+ * @at: Offset of the section.
+ * @size: Size of the section in bytes.
+ *
+ * Returns: True if the section is aligned and ends within the image.
+ */
+static bool valid_section(const struct image_header *h, uint64_t at, 
+			  uint64_t size)
+{
+	return at % 8 == 0 && at >= sizeof(struct image_header) 
+		&& at <= h->size && size <= h->size - at;
+}
+
+/**
+ * valid_ids() - Check that an array of node ids only holds valid ids.
+ * @ids: Array of ids.
+ * @count: Number of ids in the array.
+ * @n: Number of nodes.
+ *
+ * Returns: True if every id is in [0, n).
+ */
+static bool valid_ids(const int *ids, uint64_t count, int n)
+{
+	for (uint64_t i = 0; i < count; i++) {
+		if (ids[i] < 0 || ids[i] >= n) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * valid_offsets() - Check that the offsets of a CSR structure never 
+ * 		     decrease.
+ * @offsets: Array of n+1 offsets.
+ * @n: Number of nodes.
+ *
+ * Returns: True if offsets[i] <= offsets[i+1] for all i.
+ */
+static bool valid_offsets(const int *offsets, int n)
+{
+	for (int i = 0; i < n; i++) {
+		if (offsets[i] > offsets[i + 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * valid_image() - Check the header and the contents of a binary image.
+ * @image: Start of the image.
+ * @size: Size of the image in bytes.
+ *
+ * The header, the placement of the sections and the end of the string 
+ * table are checked. The contents of the sections are checked in one pass:
+ * the offsets of both CSR structures run from 0 to nr_of_edges without 
+ * decreasing, all targets and all ids in label_order are node ids, and all
+ * labels start within the string table. The order of label_order and the
+ * weights are trusted.
+ *
+ * Returns: True if the image can be loaded on this host.
+ */
+static bool valid_image(const char *image, uint64_t size)
+{
+	const struct image_header *h = (const void *)image;
+	if (size < sizeof(struct image_header)
+	    || memcmp(h->magic, IMAGE_MAGIC, sizeof(h->magic)) != 0
+	    || h->version != IMAGE_VERSION 
+	    || h->byte_order != IMAGE_BYTE_ORDER
+	    || h->int_size != sizeof(int) || h->size != size
+	    || h->nr_of_nodes < 0 || h->nr_of_edges < 0) {
+		return false;
+	}
+	uint64_t n = h->nr_of_nodes;
+	uint64_t m = h->nr_of_edges;
+	bool weighted = (h->flags & IMAGE_WEIGHTED) != 0;
+	if (!valid_section(h, h->labels, (n + 1) * sizeof(uint64_t))
+	    || !valid_section(h, h->label_order, n * sizeof(int))
+	    || !valid_section(h, h->offsets, (n + 1) * sizeof(int))
+	    || !valid_section(h, h->targets, m * sizeof(int))
+	    || (weighted 
+		&& !valid_section(h, h->weights, m * sizeof(double)))
+	    || !valid_section(h, h->offsets_in, (n + 1) * sizeof(int))
+	    || !valid_section(h, h->targets_in, m * sizeof(int))) {
+		return false;
+	}
+	const uint64_t *labels = (const void *)(image + h->labels);
+	const int *offsets = (const void *)(image + h->offsets);
+	const int *offsets_in = (const void *)(image + h->offsets_in);
+	if (!valid_section(h, h->strings, labels[n])
+	    || (n > 0 && image[h->strings + labels[n] - 1] != 0)
+	    || offsets[0] != 0 || offsets[n] != h->nr_of_edges
+	    || offsets_in[0] != 0 || offsets_in[n] != h->nr_of_edges
+	    || !valid_offsets(offsets, n) || !valid_offsets(offsets_in, n)) {
+		return false;
+	}
+	/* Each label ends at a 0 before labels[n], since the string table 
+	   ends with one. */
+	for (uint64_t i = 0; i < n; i++) {
+		if (labels[i] >= labels[n]) {
+			return false;
+		}
+	}
+	int nr_of_nodes = h->nr_of_nodes;
+	return valid_ids((const void *)(image + h->label_order), n, nr_of_nodes)
+		&& valid_ids((const void *)(image + h->targets), m, nr_of_nodes)
+		&& valid_ids((const void *)(image + h->targets_in), m, 
+			     nr_of_nodes);
+}
+
 // =================== NODE COMPARISON FUNCTION ======================
 
 /**
@@ -131,7 +673,7 @@ bool nodes_are_equal(const node *n1, const node *n2)
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The number of nodes the graph has room for from the start.
  *
  * Returns: A pointer to the new graph.
  */
@@ -139,9 +681,47 @@ graph *graph_empty(int max_nodes)
 {
 	// Allocate the graph header.
 	graph *g = calloc(1, sizeof(graph));
-	// Create array to hold the nodes. Size of array is [0, max_nodes-1].
-	g->node_array = array_1d_create(0, max_nodes-1, NULL);
+	// Create array to hold the nodes, it grows when it is full.
+	g->node_array = NULL;
+	g->capacity = 0;
+	// The label index is created at the first node insertion.
+	g->label_index = NULL;
+	g->label_order = NULL;
+	g->nr_of_nodes = 0;
+	g->nr_of_edges = 0;
+	g->frozen = NULL;
+	g->frozen_in = NULL;
+	g->edge_index = NULL;
+	g->weighted = false;
+	g->image = NULL;
+	g->image_size = 0;
+	g->node_block = NULL;
+	g->nr_in_block = 0;
+	// Stamp 0 is never a valid epoch, new nodes are not seen.
+	g->seen.nr_of_nodes = 0;
+	g->seen.epoch = 1;
+	g->seen.stamps = NULL;
+
+	graph_reserve(g, max_nodes);
+
+	return g;
+}
 
+/**
+ * graph_reserve() - Make room for a number of nodes in a graph.
+ * @g: Graph to manipulate.
+ * @nr_of_nodes: Total number of nodes to make room for.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_reserve(graph *g, int nr_of_nodes)
+{
+	if (nr_of_nodes > g->capacity) {
+		g->node_array = realloc(g->node_array, 
+					nr_of_nodes * sizeof(node *));
+		g->capacity = nr_of_nodes;
+		visit_cover(&g->seen, nr_of_nodes);
+	}
 	return g;
 }
 
@@ -179,38 +759,59 @@ graph *graph_empty(int max_nodes)
  */
 graph *graph_insert_node(graph *g, const char *s)
 {
-	/* While current position in array is nonempty, check for duplicate 
-	   node. */
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while((i <= high) && array_1d_has_value(g->node_array, i)) {
-		// Inspect node
-		node *n = array_1d_inspect_value(g->node_array, i);
-		if (strcmp(s, n->label) == 0) {
-			// Duplicate node, return the unaltered graph.
-			return g;
-		}
-		i++;
+	graph_intern_node(g, s);
+	return g;
+}
+
+/**
+ * graph_intern_node() - Find a node, inserting it first if needed.
+ * @g: Graph to manipulate.
+ * @s: Node name.
+ *
+ * Returns: A pointer to the node with the given name.
+ */
+node *graph_intern_node(graph *g, const char *s)
+{
+	// Check for duplicate node.
+	index_labels(g);
+	node *old = table_lookup(g->label_index, s);
+	if (old != NULL) {
+		// Duplicate node, leave the graph unaltered.
+		return old;
 	}
-	/* Current position in the array is empty. Allocate and insert a new 
-	   node structure at this position. */
+	/* Allocate and insert a new node structure at the first empty position
+	   in the array. */
+	int i = g->nr_of_nodes;
 	node *n = malloc(sizeof(node));
+	thaw(g);
+
+	// The position in the array is the id of the node.
+	n->id = i;
 
 	// Make a dynamic copy of the input string and insert into the node.
 	char *str = copy_string(s);
 	n->label = str;
 
 	// Initialize the node as not seen.
-	n->is_seen = false;
+	visit_cover(&g->seen, i + 1);
 
-	// Create a directed list to hold the node's neighbours.
-	dlist *l = dlist_empty(NULL);
-	n->neighbours = l;
+	// The array of neighbours is allocated at the first edge.
+	n->neighbours = NULL;
+	n->weights = NULL;
+	n->nr_of_neighbours = 0;
+	n->capacity = 0;
 
 	// Insert the node structure into the array.
-	array_1d_set_value(g->node_array, n, i);
+	if (i == g->capacity) {
+		graph_reserve(g, g->capacity > 0 ? 2 * g->capacity : 16);
+	}
+	g->node_array[i] = n;
+	g->nr_of_nodes++;
 
-	return g;
+	// Index the node by its label.
+	table_insert(g->label_index, n->label, n);
+
+	return n;
 }
 
 /**
@@ -222,18 +823,14 @@ graph *graph_insert_node(graph *g, const char *s)
  */
 node *graph_find_node(const graph *g, const char *s)
 {
-	// Traverse array until node is found, else return NULL.
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while ((i <= high) && array_1d_has_value(g->node_array, i)) {
-		node *n = array_1d_inspect_value(g->node_array, i);
-		if (strcmp(s, n->label) == 0) {
-			// Node match, return pointer to node. 
-			return n;
-		}
-		i++; 
+	// Look up the label in the index, NULL if there is no match.
+	if (g->label_index != NULL) {
+		return table_lookup(g->label_index, s);
+	}
+	// A graph loaded from an image has its ids sorted by label instead.
+	if (g->label_order != NULL) {
+		return find_in_order(g, s);
 	}
-	// No match found, return NULL.
 	return NULL;
 }
 
@@ -246,7 +843,7 @@ node *graph_find_node(const graph *g, const char *s)
  */
 bool graph_node_is_seen(const graph *g, const node *n)
 {
-	return n->is_seen;
+	return graph_visit_is_seen(&g->seen, n->id);
 }
 
 /**
@@ -259,7 +856,11 @@ bool graph_node_is_seen(const graph *g, const node *n)
  */
 graph *graph_node_set_seen(graph *g, node *n, bool seen) 
 {
-	n->is_seen = seen;
+	if (seen) {
+		graph_visit_set_seen(&g->seen, n->id);
+	} else {
+		g->seen.stamps[n->id] = 0;
+	}
 	return g;
 }
 
@@ -267,20 +868,85 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen)
  * graph_reset_seen() - Reset the seen status on all nodes in the graph.
  * @g: Graph to modify.
  *
+ * Starts a new epoch, which makes all nodes unseen. The stamps of the nodes
+ * are only cleared when the epoch counter wraps around.
+ *
  * Returns: The modified graph.
  */
 graph *graph_reset_seen(graph *g)
 {
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while ((i <= high) && array_1d_has_value(g->node_array, i)) {
-		node *n = array_1d_inspect_value(g->node_array, i);
-		n->is_seen = false;
-		i++;
-	}
+	graph_visit_reset(&g->seen);
 	return g;
 }
 
+/**
+ * graph_visit_new() - Create a visit object for a graph.
+ * @g: Graph to be traversed.
+ *
+ * Returns: A pointer to a new visit object where no node is seen.
+ */
+graph_visit *graph_visit_new(const graph *g)
+{
+	graph_visit *v = malloc(sizeof(graph_visit));
+	v->nr_of_nodes = g->nr_of_nodes;
+	v->epoch = 1;
+	v->stamps = calloc(g->nr_of_nodes > 0 ? g->nr_of_nodes : 1, 
+			   sizeof(unsigned int));
+	return v;
+}
+
+/**
+ * graph_visit_reset() - Mark all nodes as not seen.
+ * @v: Visit object to reset.
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_reset(graph_visit *v)
+{
+	v->epoch++;
+	if (v->epoch == 0) {
+		// Counter wrapped, old stamps could match new epochs.
+		memset(v->stamps, 0, v->nr_of_nodes * sizeof(unsigned int));
+		v->epoch = 1;
+	}
+}
+
+/**
+ * graph_visit_is_seen() - Return the seen status of a node.
+ * @v: Visit object to inspect.
+ * @id: Id of the node.
+ *
+ * Returns: True if the node has been marked as seen since the last reset.
+ */
+bool graph_visit_is_seen(const graph_visit *v, int id)
+{
+	return v->stamps[id] == v->epoch;
+}
+
+/**
+ * graph_visit_set_seen() - Mark a node as seen.
+ * @v: Visit object to modify.
+ * @id: Id of the node.
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_set_seen(graph_visit *v, int id)
+{
+	v->stamps[id] = v->epoch;
+}
+
+/**
+ * graph_visit_kill() - Destroy a visit object.
+ * @v: Visit object to destroy.
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_kill(graph_visit *v)
+{
+	free(v->stamps);
+	free(v);
+}
+
 /**
  * graph_insert_edge() - Insert an edge into the graph.
  * @g: Graph to manipulate.
@@ -293,38 +959,70 @@ graph *graph_reset_seen(graph *g)
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2)
 {
-	// Allocate flags and pointer to dlist. 
-	bool n1_found = false;
-	bool n2_found = false;
-	dlist *neighbourlist;
-	
-	/* Traverse the array of nodes and verify that both nodes exists 
-	   within the graph. If the source node is found, save pointer to its 
-	   list of neighbours for later. */
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while ((i <= high) && array_1d_has_value(g->node_array, i)) {
-		node *n = array_1d_inspect_value(g->node_array, i);
-		if (nodes_are_equal(n, n1)) {
-			// Source node match, flag and save dlist pointer.
-			n1_found = true;
-			neighbourlist = n->neighbours;
-		}
-		if (nodes_are_equal(n, n2)) {
-			// Destination node match, flag.
-			n2_found = true;
-		}
-		i++; 
-	}
+	return graph_insert_weighted_edge(g, n1, n2, 1.0);
+}
+
+/**
+ * graph_insert_weighted_edge() - Insert an edge with a weight into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ * @weight: Weight of the edge.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_weighted_edge(graph *g, node *n1, node *n2, 
+				  double weight)
+{
+	/* Verify through the node ids that both nodes exists within the 
+	   graph, without hashing the labels. */
+	node *src = owned_node(g, n1);
+	node *dst = owned_node(g, n2);
 
 	/* If both nodes are found, insert the edge. Otherwise return  the 
 	   unaltered graph. */
-	if (n1_found && n2_found) {
-		/* Make a dynamic copy of the destination node label and insert 
-		   into the list of neighbours for the source node.*/
-		char *str = copy_string(n2->label);
-		dlist_pos pos =  dlist_first(neighbourlist);
-		dlist_insert(neighbourlist, str, pos);
+	if (src != NULL && dst != NULL) {
+		if (!g->weighted && weight != 1.0) {
+			add_weights(g);
+		}
+		/* With an edge index, an edge is only inserted once, with the
+		   smallest weight given. */
+		if (g->edge_index != NULL) {
+			struct edge_entry *e = find_edge(g, src->id, dst->id);
+			if (e != NULL) {
+				if (g->weighted 
+				    && weight < src->weights[e->pos]) {
+					src->weights[e->pos] = weight;
+					thaw(g);
+				}
+				return g;
+			}
+		}
+		/* Append the destination id to the neighbours of the source
+		   node. The array grows by doubling. */
+		if (src->nr_of_neighbours == src->capacity) {
+			int used = src->nr_of_neighbours;
+			src->capacity = src->capacity > 0 ? 2 * src->capacity 
+							  : 4;
+			src->neighbours = resize(g, src->neighbours, 
+						 used * sizeof(int),
+						 src->capacity * sizeof(int));
+			if (g->weighted) {
+				src->weights = resize(g, src->weights, 
+						      used * sizeof(double),
+						      src->capacity 
+						      * sizeof(double));
+			}
+		}
+		if (g->edge_index != NULL) {
+			index_edge(g, src->id, dst->id, src->nr_of_neighbours);
+		}
+		if (g->weighted) {
+			src->weights[src->nr_of_neighbours] = weight;
+		}
+		src->neighbours[src->nr_of_neighbours++] = dst->id;
+		g->nr_of_edges++;
+		thaw(g);
 	}
 
 	return g;
@@ -350,14 +1048,109 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
  * @n1: Source node (pointer) for the edge.
  * @n2: Destination node (pointer) for the edge.
  *
- * Returns: The modified graph.
+ * Removes one copy of the edge. Takes constant expected time if the graph
+ * has an edge index, see graph_unique_edges(), and otherwise time linear in
+ * the out-degree of n1. The order of the remaining neighbours of n1 may
+ * change.
  *
- * NOTE: Undefined if the edge is not in the graph.
+ * Returns: The modified graph, unaltered if the edge is not in the graph.
  */
-/*graph *graph_delete_edge(graph *g, node *n1, node *n2) 
+graph *graph_delete_edge(graph *g, node *n1, node *n2)
 {
+	node *src = owned_node(g, n1);
+	node *dst = owned_node(g, n2);
+	if (src == NULL || dst == NULL) {
+		return g;
+	}
 
-}*/
+	// Find the position of the edge in the neighbour array.
+	int pos = -1;
+	if (g->edge_index != NULL) {
+		struct edge_entry *e = find_edge(g, src->id, dst->id);
+		if (e != NULL) {
+			pos = e->pos;
+			table_remove(g->edge_index, &e->key);
+		}
+	} else {
+		for (int j = 0; j < src->nr_of_neighbours; j++) {
+			if (src->neighbours[j] == dst->id) {
+				pos = j;
+				break;
+			}
+		}
+	}
+	if (pos < 0) {
+		// No such edge, return the unaltered graph.
+		return g;
+	}
+
+	// Move the last neighbour into the hole.
+	int last = src->nr_of_neighbours - 1;
+	if (pos != last) {
+		int moved = src->neighbours[last];
+		src->neighbours[pos] = moved;
+		if (g->weighted) {
+			src->weights[pos] = src->weights[last];
+		}
+		if (g->edge_index != NULL) {
+			find_edge(g, src->id, moved)->pos = pos;
+		}
+	}
+	src->nr_of_neighbours--;
+	g->nr_of_edges--;
+	thaw(g);
+
+	return g;
+}
+
+/**
+ * graph_unique_edges() - Turn on the edge index of a graph.
+ * @g: Graph to manipulate.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_unique_edges(graph *g)
+{
+	if (g->edge_index != NULL) {
+		return g;
+	}
+	// The entries own their keys, so only the values are freed.
+	g->edge_index = table_empty_hash(compare_edge_keys, hash_u64, NULL, 
+					 free);
+
+	// Index the edges, and drop the ones already seen.
+	bool modified = false;
+	for (int i = 0; i < g->nr_of_nodes; i++) {
+		node *n = g->node_array[i];
+		int kept = 0;
+		for (int j = 0; j < n->nr_of_neighbours; j++) {
+			int d = n->neighbours[j];
+			struct edge_entry *e = find_edge(g, n->id, d);
+			if (e != NULL) {
+				// Keep the smallest weight.
+				if (g->weighted 
+				    && n->weights[j] < n->weights[e->pos]) {
+					n->weights[e->pos] = n->weights[j];
+				}
+				g->nr_of_edges--;
+				modified = true;
+				continue;
+			}
+			n->neighbours[kept] = d;
+			if (g->weighted) {
+				n->weights[kept] = n->weights[j];
+			}
+			index_edge(g, n->id, d, kept);
+			kept++;
+		}
+		n->nr_of_neighbours = kept;
+	}
+	if (modified) {
+		thaw(g);
+	}
+
+	return g;
+}
 
 /**
  * graph_choose_node() - Return an arbitrary node from the graph.
@@ -379,26 +1172,190 @@ graph *graph_insert_edge(graph *g, node *n1, node *n2)
  *
  * Returns: A pointer to a list of nodes. Note: The list must be
  * dlist_kill()-ed after use.
+ *
+ * NOTE: The returned list holds dynamic copies of the neighbour labels. Use 
+ * the neighbour iterator to visit the neighbours without copying. 
  */
 dlist *graph_neighbours(const graph *g,const node *n)
 {
-	/* Traverse the array of nodes until the specific node is found and then
-	   create a dlist clone. */
-
-	dlist *l;
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while ((i <= high) && array_1d_has_value(g->node_array, i)) {
-		node *n_current = array_1d_inspect_value(g->node_array, i);
-		if (nodes_are_equal(n, n_current)) {
-			/* Node match. Create a dlist copy of this node's 
-			neighbours to return. */
-			l = clone_dlist(n->neighbours);
-			break;
+	// Create a dlist copy of this node's neighbours to return.
+	return clone_labels(g, n);
+}
+
+/**
+ * graph_neighbour_iter_begin() - Start an iteration over the neighbours of a 
+ * 				  node.
+ * @g: Graph storing the node.
+ * @n: Node to visit the neighbours of.
+ * @it: Iterator to initialize.
+ *
+ * Returns: Nothing.
+ */
+void graph_neighbour_iter_begin(const graph *g, const node *n, 
+				graph_neighbour_iter *it)
+{
+	it->g = g;
+	it->ids = n->neighbours;
+	it->nr_left = n->nr_of_neighbours;
+}
+
+/**
+ * graph_neighbour_iter_next() - Advance a neighbour iterator.
+ * @it: Iterator to advance.
+ * @m: Pointer to where the neighbour node is stored.
+ *
+ * Returns: True if a neighbour was found, false if all neighbours have been 
+ * 	    visited.
+ */
+bool graph_neighbour_iter_next(graph_neighbour_iter *it, node **m)
+{
+	if (it->nr_left == 0) {
+		return false;
+	}
+	*m = it->g->node_array[*it->ids];
+	it->ids++;
+	it->nr_left--;
+	return true;
+}
+
+/**
+ * graph_nr_of_nodes() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes in the graph.
+ */
+int graph_nr_of_nodes(const graph *g)
+{
+	return g->nr_of_nodes;
+}
+
+/**
+ * graph_node_id() - Return the id of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const graph *g, const node *n)
+{
+	return n->id;
+}
+
+/**
+ * graph_node_from_id() - Return the node with a given id.
+ * @g: Graph to inspect.
+ * @id: Node id, 0 <= id < graph_nr_of_nodes(g).
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_from_id(const graph *g, int id)
+{
+	return g->node_array[id];
+}
+
+/**
+ * graph_node_label() - Return the label of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The label of the node, owned by the graph.
+ */
+const char *graph_node_label(const graph *g, const node *n)
+{
+	return n->label;
+}
+
+/**
+ * graph_freeze() - Build a CSR representation of the edges of the graph.
+ * @g: Graph to manipulate.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_freeze(graph *g)
+{
+	if (g->frozen != NULL) {
+		// Already frozen and unmodified since.
+		return g;
+	}
+	// Collect all edges as pairs of node ids.
+	int *src = malloc((g->nr_of_edges > 0 ? g->nr_of_edges : 1) 
+			  * sizeof(int));
+	int *dst = malloc((g->nr_of_edges > 0 ? g->nr_of_edges : 1) 
+			  * sizeof(int));
+	double *weight = NULL;
+	if (g->weighted) {
+		weight = malloc((g->nr_of_edges > 0 ? g->nr_of_edges : 1) 
+				* sizeof(double));
+	}
+	int e = 0;
+	for (int i = 0; i < g->nr_of_nodes; i++) {
+		node *n = g->node_array[i];
+		for (int j = 0; j < n->nr_of_neighbours; j++) {
+			src[e] = n->id;
+			dst[e] = n->neighbours[j];
+			if (weight != NULL) {
+				weight[e] = n->weights[j];
+			}
+			e++;
 		}
-		i++;		
 	}
-	return l;
+	g->frozen = csr_build_weighted(g->nr_of_nodes, e, src, dst, weight);
+	// Swapping source and destination gives the in-edges.
+	g->frozen_in = csr_build(g->nr_of_nodes, e, dst, src);
+	free(src);
+	free(dst);
+	free(weight);
+
+	return g;
+}
+
+/**
+ * graph_has_weights() - Check if any edge of the graph has a weight other 
+ * 			 than 1.
+ * @g: Graph to inspect.
+ *
+ * Returns: True if edge weights are stored, see 
+ * 	    graph_insert_weighted_edge().
+ */
+bool graph_has_weights(const graph *g)
+{
+	return g->weighted;
+}
+
+/**
+ * graph_csr() - Return the CSR representation of the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the CSR structure built by graph_freeze(), or NULL
+ * 	    if the graph has been modified since it was last frozen.
+ */
+const csr *graph_csr(const graph *g)
+{
+	return g->frozen;
+}
+
+/**
+ * graph_csr_in() - Return the reverse CSR representation of the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the CSR structure of the in-edges built by 
+ * 	    graph_freeze(), or NULL if the graph has been modified since it was
+ * 	    last frozen.
+ */
+const csr *graph_csr_in(const graph *g)
+{
+	return g->frozen_in;
+}
+
+/**
+ * graph_version() - Return the version of the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A number that changes every time the graph is modified.
+ */
+unsigned long graph_version(const graph *g)
+{
+	return g->version;
 }
 
 /**
@@ -412,31 +1369,43 @@ dlist *graph_neighbours(const graph *g,const node *n)
 void graph_kill(graph *g)
 {
 	// Traverse the array and deallocate each node structure. 
-	int i = 0;
-	int high = array_1d_high(g->node_array);
-	while((i <= high) && array_1d_has_value(g->node_array, i)) {
+	for (int i = 0; i < g->nr_of_nodes; i++) {
 		// Inspect the node.
-		node *n = array_1d_inspect_value(g->node_array, i);
+		node *n = g->node_array[i];
 		
-		// Traverse the list and deallocate each cell and value.
-		dlist_pos p = dlist_first(n->neighbours); 
-		while (!dlist_is_end(n->neighbours, p)) {
-			char *v = dlist_inspect(n->neighbours, p);
-			free(v);
-			p = dlist_remove(n->neighbours, p);
+		/* Free the neighbour ids. The neighbour nodes are deallocated
+		   as part of the array. Arrays in the image are unmapped 
+		   below. */
+		if (!in_image(g, n->neighbours)) {
+			free(n->neighbours);
+		}
+		if (!in_image(g, n->weights)) {
+			free(n->weights);
 		}
-		// Destroy the list.
-		dlist_kill(n->neighbours);
 
 		// Deallocate the label and the node strucure itself.
-		free(n->label);
-		free(n);
-
-		// Traverse the array
-		i++;
+		if (!in_image(g, n->label)) {
+			free(n->label);
+		}
+		if (g->node_block == NULL || n < g->node_block 
+		    || n >= g->node_block + g->nr_in_block) {
+			free(n);
+		}
+	}
+	free(g->node_block);
+	// Destroy the index, the array and the graph itself.
+	thaw(g);
+	free(g->seen.stamps);
+	if (g->edge_index != NULL) {
+		table_kill(g->edge_index);
+	}
+	if (g->label_index != NULL) {
+		table_kill(g->label_index);
+	}
+	free(g->node_array);
+	if (g->image != NULL) {
+		munmap(g->image, g->image_size);
 	}
-	// Destroy the array and the graph itself.
-	array_1d_kill(g->node_array);
 	free(g);
 }
 
@@ -453,3 +1422,198 @@ void graph_kill(graph *g)
 
 }*/
 
+// =================== BINARY IMAGE INTERFACE ======================
+
+/**
+ * graph_save_binary() - Save a graph as a binary image.
+ * @g: Graph to save. It is frozen first, see graph_freeze().
+ * @filename: Name of the image file to write.
+ *
+ * Returns: True if the image was written, otherwise false with errno set.
+ */
+bool graph_save_binary(graph *g, const char *filename)
+{
+	graph_freeze(g);
+	const csr *out = g->frozen;
+	const csr *in = g->frozen_in;
+	int n = g->nr_of_nodes;
+	int m = out->nr_of_edges;
+
+	// Offsets of the labels in the string table.
+	uint64_t *labels = malloc((n + 1) * sizeof(uint64_t));
+	labels[0] = 0;
+	for (int i = 0; i < n; i++) {
+		labels[i + 1] = labels[i] + strlen(g->node_array[i]->label) + 1;
+	}
+	// The ids sorted by label, for lookups without the label index.
+	node **sorted = malloc((n > 0 ? n : 1) * sizeof(node *));
+	memcpy(sorted, g->node_array, n * sizeof(node *));
+	qsort(sorted, n, sizeof(node *), compare_node_labels);
+	int *label_order = malloc((n > 0 ? n : 1) * sizeof(int));
+	for (int i = 0; i < n; i++) {
+		label_order[i] = sorted[i]->id;
+	}
+	free(sorted);
+
+	struct image_header h;
+	memset(&h, 0, sizeof(h));
+	memcpy(h.magic, IMAGE_MAGIC, sizeof(h.magic));
+	h.version = IMAGE_VERSION;
+	h.byte_order = IMAGE_BYTE_ORDER;
+	h.int_size = sizeof(int);
+	h.flags = out->weights != NULL ? IMAGE_WEIGHTED : 0;
+	h.nr_of_nodes = n;
+	h.nr_of_edges = m;
+
+	// Lay out the sections one after the other.
+	uint64_t at = align8(sizeof(h));
+	h.labels = at;
+	at += align8((n + 1) * sizeof(uint64_t));
+	h.strings = at;
+	at += align8(labels[n]);
+	h.label_order = at;
+	at += align8(n * sizeof(int));
+	h.offsets = at;
+	at += align8((n + 1) * sizeof(int));
+	h.targets = at;
+	at += align8(m * sizeof(int));
+	if (out->weights != NULL) {
+		h.weights = at;
+		at += align8(m * sizeof(double));
+	}
+	h.offsets_in = at;
+	at += align8((n + 1) * sizeof(int));
+	h.targets_in = at;
+	at += align8(m * sizeof(int));
+	h.size = at;
+
+	FILE *f = fopen(filename, "wb");
+	bool ok = f != NULL 
+		&& write_section(f, &h, sizeof(h))
+		&& write_section(f, labels, (n + 1) * sizeof(uint64_t));
+	for (int i = 0; ok && i < n; i++) {
+		const char *label = g->node_array[i]->label;
+		size_t len = strlen(label) + 1;
+		ok = fwrite(label, 1, len, f) == len;
+	}
+	ok = ok && write_padding(f, labels[n])
+		&& write_section(f, label_order, n * sizeof(int))
+		&& write_section(f, out->offsets, (n + 1) * sizeof(int))
+		&& write_section(f, out->targets, m * sizeof(int))
+		&& (out->weights == NULL 
+		    || write_section(f, out->weights, m * sizeof(double)))
+		&& write_section(f, in->offsets, (n + 1) * sizeof(int))
+		&& write_section(f, in->targets, m * sizeof(int));
+	if (f != NULL && fclose(f) != 0) {
+		ok = false;
+	}
+	free(labels);
+	free(label_order);
+
+	return ok;
+}
+
+/**
+ * graph_is_binary() - Check if a file holds a binary image of a graph.
+ * @filename: Name of the file.
+ *
+ * Returns: True if the file starts like a binary image.
+ */
+bool graph_is_binary(const char *filename)
+{
+	char magic[sizeof(IMAGE_MAGIC) - 1];
+	FILE *f = fopen(filename, "rb");
+	if (f == NULL) {
+		return false;
+	}
+	bool is_image = fread(magic, 1, sizeof(magic), f) == sizeof(magic)
+		&& memcmp(magic, IMAGE_MAGIC, sizeof(magic)) == 0;
+	fclose(f);
+	return is_image;
+}
+
+/**
+ * graph_load_binary() - Load a graph from a binary image.
+ * @filename: Name of the image file, written by graph_save_binary().
+ *
+ * Returns: A pointer to the frozen graph, or NULL with errno set. errno is
+ * 	    EINVAL if the file is not an image that can be loaded on this host.
+ */
+graph *graph_load_binary(const char *filename)
+{
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		return NULL;
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		return NULL;
+	}
+	if (st.st_size < (off_t)sizeof(struct image_header)) {
+		close(fd);
+		errno = EINVAL;
+		return NULL;
+	}
+	/* A private, writable mapping lets the graph modify its arrays in 
+	   place without changing the file. */
+	char *image = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, 
+			   MAP_PRIVATE, fd, 0);
+	int mmap_errno = errno;
+	close(fd);
+	if (image == MAP_FAILED) {
+		errno = mmap_errno;
+		return NULL;
+	}
+	if (!valid_image(image, st.st_size)) {
+		munmap(image, st.st_size);
+		errno = EINVAL;
+		return NULL;
+	}
+
+	const struct image_header *h = (const void *)image;
+	int n = h->nr_of_nodes;
+	int m = h->nr_of_edges;
+	const uint64_t *labels = (const void *)(image + h->labels);
+	char *strings = image + h->strings;
+	int *offsets = (void *)(image + h->offsets);
+	int *targets = (void *)(image + h->targets);
+	double *weights = NULL;
+	if ((h->flags & IMAGE_WEIGHTED) != 0) {
+		weights = (void *)(image + h->weights);
+	}
+
+	graph *g = graph_empty(n);
+	g->image = image;
+	g->image_size = st.st_size;
+	g->label_order = (const void *)(image + h->label_order);
+	g->weighted = weights != NULL;
+
+	// All nodes in one block, with their labels and edges in the image.
+	g->node_block = malloc((n > 0 ? n : 1) * sizeof(node));
+	g->nr_in_block = n;
+	for (int i = 0; i < n; i++) {
+		node *v = &g->node_block[i];
+		int degree = offsets[i + 1] - offsets[i];
+		v->id = i;
+		v->label = strings + labels[i];
+		// As in graph_intern_node(), nodes without edges have no array.
+		v->neighbours = degree > 0 ? &targets[offsets[i]] : NULL;
+		v->weights = NULL;
+		if (weights != NULL && degree > 0) {
+			v->weights = &weights[offsets[i]];
+		}
+		v->nr_of_neighbours = degree;
+		v->capacity = degree;
+		g->node_array[i] = v;
+	}
+	g->nr_of_nodes = n;
+	g->nr_of_edges = m;
+
+	// The image holds both CSR structures, the graph is already frozen.
+	g->frozen = csr_wrap(n, m, offsets, targets, weights);
+	g->frozen_in = csr_wrap(n, m, (void *)(image + h->offsets_in),
+				(void *)(image + h->targets_in), NULL);
+
+	return g;
+}
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include "util.h"
 #include "dlist.h"
+#include "csr.h"
 
 /*
  * Declaration of a generic graph for the "Datastructures and
@@ -28,6 +29,24 @@
  *   v1.1  2019-03-06: Changed several const node * to node *.
  *                     Fixed doc bug to state that any dynamic memory allocated
  *                     to the node NAMES is the resposibility of the user.
+ *   v1.2  2026-10-17: Added dense integer node ids and a frozen CSR
+ *                     representation of the edges, see graph_freeze().
+ *                     (Elias Olofsson, tfy17eon@cs.umu.se)
+ *   v1.3  2026-10-17: Added the neighbour iterator.
+ *   v1.4  2026-10-17: graph_reset_seen() is O(1). Added visit objects.
+ *   v1.5  2026-10-17: Added graph_csr_in().
+ *   v1.6  2026-10-17: Added graph_version().
+ *   v1.7  2026-10-17: Doc update on using visit objects from threads.
+ *   v1.8  2026-10-17: Added graph_intern_node().
+ *   v1.9  2026-10-17: The neighbour iterator walks an array of node ids.
+ *   v2.0  2026-10-17: Added graph_unique_edges(). Doc update in 
+ *                     graph_insert_edge() and graph_delete_edge().
+ *   v2.1  2026-10-17: The graph grows beyond the size given to
+ *                     graph_empty(). Added graph_reserve().
+ *   v2.2  2026-10-17: Added graph_insert_weighted_edge() and 
+ *                     graph_has_weights().
+ *   v2.3  2026-10-17: Added graph_save_binary(), graph_is_binary() and
+ *                     graph_load_binary().
  */
 
 // ====================== PUBLIC DATA TYPES ==========================
@@ -36,6 +55,17 @@
 typedef struct node node;
 typedef struct graph graph;
 
+// Visit state of a traversal, see graph_visit_new().
+typedef struct graph_visit graph_visit;
+
+// Neighbour iterator type. Declared here so that iterators can be placed on
+// the stack. The fields are only to be used by the graph implementation.
+typedef struct graph_neighbour_iter {
+	const graph *g;
+	const int *ids;
+	int nr_left;
+} graph_neighbour_iter;
+
 // =================== NODE COMPARISON FUNCTION ======================
 
 /**
@@ -52,12 +82,28 @@ bool nodes_are_equal(const node *n1,const node *n2);
 
 /**
  * graph_empty() - Create an empty graph.
- * @max_nodes: The maximum number of nodes the graph can hold.
+ * @max_nodes: The number of nodes the graph has room for from the start.
+ *
+ * The graph grows as needed when more nodes are inserted, see also
+ * graph_reserve().
  *
  * Returns: A pointer to the new graph.
  */
 graph *graph_empty(int max_nodes);
 
+/**
+ * graph_reserve() - Make room for a number of nodes in a graph.
+ * @g: Graph to manipulate.
+ * @nr_of_nodes: Total number of nodes to make room for.
+ *
+ * A hint only: without it, the room for nodes doubles whenever it is full,
+ * so inserting a node takes amortized constant time either way. Reserving
+ * room for a known number of nodes up front avoids the copying.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_reserve(graph *g, int nr_of_nodes);
+
 /**
  * graph_is_empty() - Check if a graph is empty, i.e. has no nodes.
  * @g: Graph to check.
@@ -86,6 +132,18 @@ bool graph_has_edges(const graph *g);
  */
 graph *graph_insert_node(graph *g, const char *s);
 
+/**
+ * graph_intern_node() - Find a node, inserting it first if needed.
+ * @g: Graph to manipulate.
+ * @s: Node name.
+ *
+ * Same as graph_insert_node() followed by graph_find_node(), but with a
+ * single lookup of the name.
+ *
+ * Returns: A pointer to the node with the given name.
+ */
+node *graph_intern_node(graph *g, const char *s);
+
 /**
  * graph_find_node() - Find a node stored in the graph.
  * @g: Graph to manipulate.
@@ -118,10 +176,63 @@ graph *graph_node_set_seen(graph *g, node *n, bool seen);
  * graph_reset_seen() - Reset the seen status on all nodes in the graph.
  * @g: Graph to modify.
  *
+ * Takes constant time, except for every 2^32-th call.
+ *
  * Returns: The modified graph.
  */
 graph *graph_reset_seen(graph *g);
 
+/**
+ * graph_visit_new() - Create a visit object for a graph.
+ * @g: Graph to be traversed.
+ *
+ * A visit object holds the seen status of the nodes of the graph, indexed by
+ * node id, independently of the seen status stored in the graph. Several 
+ * visit objects may be used at the same time, e.g. one per thread while
+ * several threads traverse a graph that is not modified. The object only
+ * covers the nodes in the graph when it was created. After use, the function
+ * graph_visit_kill() must be called.
+ *
+ * Returns: A pointer to a new visit object where no node is seen.
+ */
+graph_visit *graph_visit_new(const graph *g);
+
+/**
+ * graph_visit_reset() - Mark all nodes as not seen.
+ * @v: Visit object to reset.
+ *
+ * Takes constant time, except for every 2^32-th call.
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_reset(graph_visit *v);
+
+/**
+ * graph_visit_is_seen() - Return the seen status of a node.
+ * @v: Visit object to inspect.
+ * @id: Id of the node, see graph_node_id().
+ *
+ * Returns: True if the node has been marked as seen since the last reset.
+ */
+bool graph_visit_is_seen(const graph_visit *v, int id);
+
+/**
+ * graph_visit_set_seen() - Mark a node as seen.
+ * @v: Visit object to modify.
+ * @id: Id of the node, see graph_node_id().
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_set_seen(graph_visit *v, int id);
+
+/**
+ * graph_visit_kill() - Destroy a visit object.
+ * @v: Visit object to destroy.
+ *
+ * Returns: Nothing.
+ */
+void graph_visit_kill(graph_visit *v);
+
 /**
  * graph_insert_edge() - Insert an edge into the graph.
  * @g: Graph to manipulate.
@@ -130,10 +241,31 @@ graph *graph_reset_seen(graph *g);
  *
  * NOTE: Undefined unless both nodes are already in the graph.
  *
+ * The same edge may be inserted several times, unless the graph has an edge
+ * index, see graph_unique_edges().
+ *
  * Returns: The modified graph.
  */
 graph *graph_insert_edge(graph *g, node *n1, node *n2);
 
+/**
+ * graph_insert_weighted_edge() - Insert an edge with a weight into the graph.
+ * @g: Graph to manipulate.
+ * @n1: Source node (pointer) for the edge.
+ * @n2: Destination node (pointer) for the edge.
+ * @weight: Weight of the edge, e.g. a distance.
+ *
+ * NOTE: Undefined unless both nodes are already in the graph.
+ *
+ * graph_insert_edge() inserts edges with weight 1. With an edge index, see
+ * graph_unique_edges(), an edge that is already in the graph keeps the 
+ * smallest of its weights.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_insert_weighted_edge(graph *g, node *n1, node *n2, 
+				  double weight);
+
 /**
  * graph_delete_node() - Remove a node from the graph.
  * @g: Graph to manipulate.
@@ -151,12 +283,29 @@ graph *graph_delete_node(graph *g, node *n);
  * @n1: Source node (pointer) for the edge.
  * @n2: Destination node (pointer) for the edge.
  *
- * Returns: The modified graph.
+ * Removes one copy of the edge. Takes constant expected time if the graph
+ * has an edge index, see graph_unique_edges(), and otherwise time linear in
+ * the out-degree of n1. The order of the remaining neighbours of n1 may
+ * change.
  *
- * NOTE: Undefined if the edge is not in the graph.
+ * Returns: The modified graph, unaltered if the edge is not in the graph.
  */
 graph *graph_delete_edge(graph *g, node *n1, node *n2);
 
+/**
+ * graph_unique_edges() - Turn on the edge index of a graph.
+ * @g: Graph to manipulate.
+ *
+ * The edge index is a hash set of all (source, destination) pairs. Any 
+ * duplicate edges already in the graph are removed. Afterwards, 
+ * graph_insert_edge() ignores edges that are already in the graph, and 
+ * graph_delete_edge() takes constant expected time. The index costs memory
+ * for every edge, so it is off by default.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_unique_edges(graph *g);
+
 /**
  * graph_choose_node() - Return an arbitrary node from the graph.
  * @g: Graph to inspect.
@@ -177,6 +326,130 @@ node *graph_choose_node(const graph *g);
  */
 dlist *graph_neighbours(const graph *g,const node *n);
 
+/**
+ * graph_nr_of_nodes() - Return the number of nodes in the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: The number of nodes in the graph.
+ */
+int graph_nr_of_nodes(const graph *g);
+
+/**
+ * graph_node_id() - Return the id of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * The nodes of a graph with N nodes have the ids 0, ..., N-1, in the order
+ * they were inserted.
+ *
+ * Returns: The id of the node.
+ */
+int graph_node_id(const graph *g, const node *n);
+
+/**
+ * graph_node_from_id() - Return the node with a given id.
+ * @g: Graph to inspect.
+ * @id: Node id, 0 <= id < graph_nr_of_nodes(g).
+ *
+ * Returns: A pointer to the node.
+ */
+node *graph_node_from_id(const graph *g, int id);
+
+/**
+ * graph_node_label() - Return the label of a node.
+ * @g: Graph storing the node.
+ * @n: Node in the graph.
+ *
+ * Returns: The label of the node, owned by the graph.
+ */
+const char *graph_node_label(const graph *g, const node *n);
+
+/**
+ * graph_freeze() - Build a CSR representation of the edges of the graph.
+ * @g: Graph to manipulate.
+ *
+ * Packs all edges into a CSR structure indexed by node id, see csr.h, and 
+ * the reversed edges into a second CSR structure. The weights of the edges,
+ * if any, are only packed into the first one. The structures stay valid
+ * until the graph is modified, after which graph_freeze() has to be called
+ * again.
+ *
+ * Returns: The modified graph.
+ */
+graph *graph_freeze(graph *g);
+
+/**
+ * graph_has_weights() - Check if any edge of the graph has a weight other 
+ * 			 than 1.
+ * @g: Graph to inspect.
+ *
+ * If it has, the CSR structure built by graph_freeze() holds the weights of
+ * the edges, otherwise its weights are NULL.
+ *
+ * Returns: True if edge weights are stored, see 
+ * 	    graph_insert_weighted_edge().
+ */
+bool graph_has_weights(const graph *g);
+
+/**
+ * graph_csr() - Return the CSR representation of the graph.
+ * @g: Graph to inspect.
+ *
+ * Returns: A pointer to the CSR structure built by graph_freeze(), or NULL
+ * 	    if the graph has been modified since it was last frozen.
+ */
+const csr *graph_csr(const graph *g);
+
+/**
+ * graph_csr_in() - Return the reverse CSR representation of the graph.
+ * @g: Graph to inspect.
+ *
+ * In the reverse structure, the neighbours of a node are the sources of the
+ * edges entering the node.
+ *
+ * Returns: A pointer to the CSR structure of the in-edges built by 
+ * 	    graph_freeze(), or NULL if the graph has been modified since it was
+ * 	    last frozen.
+ */
+const csr *graph_csr_in(const graph *g);
+
+/**
+ * graph_version() - Return the version of the graph.
+ * @g: Graph to inspect.
+ *
+ * The version changes every time a node or an edge is inserted into or 
+ * removed from the graph. Can be used to detect that information derived 
+ * from the graph, e.g. cached answers, is out of date.
+ *
+ * Returns: A number that changes every time the graph is modified.
+ */
+unsigned long graph_version(const graph *g);
+
+/**
+ * graph_neighbour_iter_begin() - Start an iteration over the neighbours of a 
+ * 				  node.
+ * @g: Graph storing the node.
+ * @n: Node to visit the neighbours of.
+ * @it: Iterator to initialize.
+ *
+ * The neighbours are visited directly in the graph, without copying. The 
+ * graph must not be modified during the iteration.
+ *
+ * Returns: Nothing.
+ */
+void graph_neighbour_iter_begin(const graph *g, const node *n, 
+				graph_neighbour_iter *it);
+
+/**
+ * graph_neighbour_iter_next() - Advance a neighbour iterator.
+ * @it: Iterator to advance.
+ * @m: Pointer to where the neighbour node is stored.
+ *
+ * Returns: True if a neighbour was found, false if all neighbours have been 
+ * 	    visited.
+ */
+bool graph_neighbour_iter_next(graph_neighbour_iter *it, node **m);
+
 /**
  * graph_kill() - Destroy a given graph.
  * @g: Graph to destroy.
@@ -187,6 +460,44 @@ dlist *graph_neighbours(const graph *g,const node *n);
  */
 void graph_kill(graph *g);
 
+// =================== BINARY IMAGE INTERFACE ======================
+
+/**
+ * graph_save_binary() - Save a graph as a binary image.
+ * @g: Graph to save. It is frozen first, see graph_freeze().
+ * @filename: Name of the image file to write.
+ *
+ * The image holds the labels and the CSR structures of the graph, laid out
+ * so that graph_load_binary() can map it without parsing. It can only be 
+ * loaded on hosts with the same byte order and int size.
+ *
+ * Returns: True if the image was written, otherwise false with errno set.
+ */
+bool graph_save_binary(graph *g, const char *filename);
+
+/**
+ * graph_is_binary() - Check if a file holds a binary image of a graph.
+ * @filename: Name of the file.
+ *
+ * Only the first bytes of the file are read.
+ *
+ * Returns: True if the file starts like a binary image.
+ */
+bool graph_is_binary(const char *filename);
+
+/**
+ * graph_load_binary() - Load a graph from a binary image.
+ * @filename: Name of the image file, written by graph_save_binary().
+ *
+ * The image is memory-mapped and the graph uses it in place. No memory is
+ * allocated per node or edge, and the graph is frozen from the start. It 
+ * can still be modified, like any other graph.
+ *
+ * Returns: A pointer to the frozen graph, or NULL with errno set. errno is
+ * 	    EINVAL if the file is not an image that can be loaded on this host.
+ */
+graph *graph_load_binary(const char *filename);
+
 /**
  * graph_print() - Iterate over the graph elements and print their values.
  * @g: Graph to inspect.
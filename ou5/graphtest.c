@@ -0,0 +1,352 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "graph.h"
+#include "path.h"
+
+/*
+ * Test program for the edge operations of the OU5 graph, see graph.h. A
+ * random sequence of edge insertions and deletions is applied both to a
+ * graph and to a matrix of edge counts and weights, and after every step
+ * the packed out-edges and weights of each node are compared with the
+ * matrix. At regular intervals, the hop counts and weights of the shortest
+ * paths found by path.h are compared with the matrix as well.
+ *
+ * The sequence is run without the edge index, where graph_delete_edge()
+ * scans the neighbour array, with the edge index of graph_unique_edges()
+ * turned on from the start, and with the index turned on halfway through,
+ * when the graph holds repeated edges. Each deletion moves the last
+ * neighbour of the node into the hole, so the index entry and the weight
+ * of the moved edge are checked by the steps that follow.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *
+ * Useage: ./graphtest
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+#define NR_OF_NODES 12
+#define NR_OF_STEPS 4000
+
+// Number of steps between two comparisons of all shortest paths.
+#define PATH_CHECK_INTERVAL 100
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+// The edges the graph should hold.
+struct model {
+	bool indexed;
+	int count[NR_OF_NODES][NR_OF_NODES];	// Copies of each edge.
+	double weight[NR_OF_NODES][NR_OF_NODES];// Weight of each edge.
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * fail() - Print a message about a failed test and exit.
+ * @msg: The message.
+ * @step: Step of the sequence where the test failed.
+ *
+ * Returns: Nothing, the program exits.
+ */
+static void fail(const char *msg, int step)
+{
+	printf("FAIL: %s (step %d).\n", msg, step);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * new_graph() - Create a graph with the nodes n0, n1, ... of the test.
+ *
+ * Returns: Pointer to the new graph.
+ */
+static graph *new_graph(void)
+{
+	graph *g = graph_empty(NR_OF_NODES);
+	for (int v = 0; v < NR_OF_NODES; v++) {
+		char label[16];
+		sprintf(label, "n%d", v);
+		graph_insert_node(g, label);
+	}
+	return g;
+}
+
+/**
+ * pair_weight() - Weight of all copies of an edge without the edge index.
+ * @u: Id of the source node.
+ * @v: Id of the destination node.
+ *
+ * Without the index, graph_delete_edge() may remove any copy of a repeated
+ * edge, so all copies are given the same weight.
+ *
+ * Returns: The weight, a multiple of 0.25 so that sums are exact.
+ */
+static double pair_weight(int u, int v)
+{
+	return 0.25 * ((3 * u + 5 * v) % 9);
+}
+
+/**
+ * insert_edge() - Insert an edge into the graph and the model.
+ * @g: Graph to manipulate.
+ * @m: Model of the graph.
+ * @u: Id of the source node.
+ * @v: Id of the destination node.
+ * @weight: Weight of the edge.
+ *
+ * Returns: Nothing.
+ */
+static void insert_edge(graph *g, struct model *m, int u, int v,
+			double weight)
+{
+	graph_insert_weighted_edge(g, graph_node_from_id(g, u),
+				   graph_node_from_id(g, v), weight);
+	if (m->count[u][v] == 0) {
+		m->weight[u][v] = weight;
+		m->count[u][v] = 1;
+	} else if (m->indexed) {
+		// The index keeps one copy with the smallest weight.
+		if (weight < m->weight[u][v]) {
+			m->weight[u][v] = weight;
+		}
+	} else {
+		m->count[u][v]++;
+	}
+}
+
+/**
+ * delete_edge() - Delete an edge from the graph and the model.
+ * @g: Graph to manipulate.
+ * @m: Model of the graph.
+ * @u: Id of the source node.
+ * @v: Id of the destination node.
+ *
+ * The edge need not be in the graph.
+ *
+ * Returns: Nothing.
+ */
+static void delete_edge(graph *g, struct model *m, int u, int v)
+{
+	graph_delete_edge(g, graph_node_from_id(g, u),
+			  graph_node_from_id(g, v));
+	if (m->count[u][v] > 0) {
+		m->count[u][v]--;
+	}
+}
+
+/**
+ * check_edges() - Compare the packed edges of a graph with the model.
+ * @g: Graph to inspect.
+ * @m: Model of the graph.
+ * @step: Current step of the sequence, for messages.
+ *
+ * Returns: Nothing, the program exits if the edges differ.
+ */
+static void check_edges(graph *g, const struct model *m, int step)
+{
+	graph_freeze(g);
+	const csr *c = graph_csr(g);
+	int nr_of_edges = 0;
+	for (int u = 0; u < NR_OF_NODES; u++) {
+		int count[NR_OF_NODES] = {0};
+		for (int k = c->offsets[u]; k < c->offsets[u + 1]; k++) {
+			int v = c->targets[k];
+			double weight = c->weights != NULL ? c->weights[k] : 1;
+			if (weight != m->weight[u][v]) {
+				fail("Edge has the wrong weight", step);
+			}
+			count[v]++;
+		}
+		for (int v = 0; v < NR_OF_NODES; v++) {
+			if (count[v] != m->count[u][v]) {
+				fail("Edge has the wrong number of copies",
+				     step);
+			}
+			nr_of_edges += m->count[u][v];
+		}
+	}
+	if (c->nr_of_edges != nr_of_edges) {
+		fail("Graph has the wrong number of edges", step);
+	}
+}
+
+/**
+ * check_paths() - Compare the shortest paths of a graph with the model.
+ * @g: Graph to inspect, frozen by check_edges().
+ * @m: Model of the graph.
+ * @step: Current step of the sequence, for messages.
+ *
+ * The expected hop counts and weights are computed with Floyd-Warshall.
+ *
+ * Returns: Nothing, the program exits if any path differs.
+ */
+static void check_paths(const graph *g, const struct model *m, int step)
+{
+	int hops[NR_OF_NODES][NR_OF_NODES];
+	double dist[NR_OF_NODES][NR_OF_NODES];
+	for (int u = 0; u < NR_OF_NODES; u++) {
+		for (int v = 0; v < NR_OF_NODES; v++) {
+			bool edge = m->count[u][v] > 0;
+			hops[u][v] = u == v ? 0 : edge ? 1 : -1;
+			dist[u][v] = u == v ? 0 : edge ? m->weight[u][v] : -1;
+		}
+	}
+	for (int k = 0; k < NR_OF_NODES; k++) {
+		for (int u = 0; u < NR_OF_NODES; u++) {
+			for (int v = 0; v < NR_OF_NODES; v++) {
+				if (hops[u][k] < 0 || hops[k][v] < 0) {
+					continue;
+				}
+				int h = hops[u][k] + hops[k][v];
+				if (hops[u][v] < 0 || h < hops[u][v]) {
+					hops[u][v] = h;
+				}
+				double d = dist[u][k] + dist[k][v];
+				if (dist[u][v] < 0 || d < dist[u][v]) {
+					dist[u][v] = d;
+				}
+			}
+		}
+	}
+
+	path_search *ps = path_search_new(g);
+	for (int u = 0; u < NR_OF_NODES; u++) {
+		for (int v = 0; v < NR_OF_NODES; v++) {
+			if (graph_shortest_path(ps, u, v, NULL) != hops[u][v]) {
+				fail("Shortest path has the wrong hop count",
+				     step);
+			}
+			if (graph_weighted_shortest_path(ps, u, v, NULL, NULL)
+			    != dist[u][v]) {
+				fail("Cheapest path has the wrong weight",
+				     step);
+			}
+		}
+	}
+	path_search_kill(ps);
+}
+
+/**
+ * run_sequence() - Insert and delete random edges, checking every step.
+ * @index_at: Step where the edge index is turned on, 0 for the start, or
+ * 	      NR_OF_STEPS for never.
+ * @seed: Seed of the random sequence.
+ *
+ * Deletions are as common as insertions, and half of them are aimed at
+ * edges in the graph. Without the index, repeated edges build up.
+ *
+ * Returns: Nothing, the program exits if a check fails.
+ */
+static void run_sequence(int index_at, unsigned int seed)
+{
+	static const double weights[] = {1, 0.5, 2, 3.25, 0};
+	graph *g = new_graph();
+	struct model m = {0};
+	srand(seed);
+
+	for (int step = 0; step < NR_OF_STEPS; step++) {
+		if (step == index_at) {
+			graph_unique_edges(g);
+			m.indexed = true;
+			// The repeated edges are dropped, all copies have the
+			// same weight.
+			for (int u = 0; u < NR_OF_NODES; u++) {
+				for (int v = 0; v < NR_OF_NODES; v++) {
+					if (m.count[u][v] > 1) {
+						m.count[u][v] = 1;
+					}
+				}
+			}
+		}
+		int u = rand() % NR_OF_NODES;
+		int v = rand() % NR_OF_NODES;
+		int op = rand() % 4;
+		if (op == 0) {
+			// Delete an edge leaving u, picked from the model.
+			int first = rand() % NR_OF_NODES;
+			for (int i = 0; i < NR_OF_NODES; i++) {
+				int w = (first + i) % NR_OF_NODES;
+				if (m.count[u][w] > 0) {
+					v = w;
+					break;
+				}
+			}
+			delete_edge(g, &m, u, v);
+		} else if (op == 1) {
+			// Delete an edge that may not be in the graph.
+			delete_edge(g, &m, u, v);
+		} else {
+			double weight = m.indexed
+				? weights[rand() % (sizeof(weights)
+						    / sizeof(weights[0]))]
+				: pair_weight(u, v);
+			insert_edge(g, &m, u, v, weight);
+		}
+		check_edges(g, &m, step);
+		if (step % PATH_CHECK_INTERVAL == 0) {
+			check_paths(g, &m, step);
+		}
+	}
+	check_paths(g, &m, NR_OF_STEPS);
+	graph_kill(g);
+}
+
+/**
+ * test_unique_edges_keeps_smallest_weight() - Check the weight kept when
+ * 					       repeated edges are dropped.
+ *
+ * Three copies of an edge with different weights are inserted without the
+ * index. Turning the index on keeps one copy with the smallest weight.
+ * After that, inserting the edge with a larger weight changes nothing,
+ * while deleting and inserting it again gives it the new weight.
+ *
+ * Returns: Nothing, the program exits if a check fails.
+ */
+static void test_unique_edges_keeps_smallest_weight(void)
+{
+	graph *g = new_graph();
+	struct model m = {0};
+	m.count[0][1] = 1;
+	m.weight[0][1] = 2;
+	m.count[0][2] = 1;
+	m.weight[0][2] = 1;
+
+	node *n0 = graph_node_from_id(g, 0);
+	node *n1 = graph_node_from_id(g, 1);
+	node *n2 = graph_node_from_id(g, 2);
+	graph_insert_weighted_edge(g, n0, n1, 3);
+	graph_insert_weighted_edge(g, n0, n2, 1);
+	graph_insert_weighted_edge(g, n0, n1, 2);
+	graph_insert_weighted_edge(g, n0, n1, 5);
+	graph_unique_edges(g);
+	check_edges(g, &m, 0);
+
+	graph_insert_weighted_edge(g, n0, n1, 4);
+	check_edges(g, &m, 1);
+
+	graph_delete_edge(g, n0, n1);
+	graph_insert_weighted_edge(g, n0, n1, 4);
+	m.weight[0][1] = 4;
+	check_edges(g, &m, 2);
+	check_paths(g, &m, 2);
+	graph_kill(g);
+}
+
+int main(void)
+{
+	run_sequence(NR_OF_STEPS, 1);
+	printf("Inserting and deleting edges without the edge index - OK\n");
+	run_sequence(0, 2);
+	printf("Inserting and deleting edges with the edge index - OK\n");
+	run_sequence(NR_OF_STEPS / 2, 3);
+	printf("Turning on the edge index with repeated edges - OK\n");
+	test_unique_edges_keeps_smallest_weight();
+	printf("Keeping the smallest weight of repeated edges - OK\n");
+	printf("All tests succeeded!\n");
+	return 0;
+}
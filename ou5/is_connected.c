@@ -4,11 +4,20 @@
 #include <stdbool.h>	
 #include <errno.h>	
 #include <ctype.h>	
+#include <pthread.h>
 
 #include "graph.h"
-#include "queue.h"
-
-#define BUFSIZE 300	/* Max 300 chars per line in the input map file. */
+#include "scc.h"
+#include "querycache.h"
+#include "csr.h"
+#include "mapfile.h"
+#include "path.h"
+
+#define BUFSIZE 300	/* Max 300 chars per line in the question file. */
+#define CACHE_PAIRS 4096	/* Max number of cached answers. */
+#define CACHE_SOURCES 16	/* Max number of cached reachable sets. */
+#define MAX_THREADS 64	/* Max number of threads in batch mode. */
+#define BATCH_CHUNK 16	/* Origins taken by a thread at a time. */
 
 /* 
  * OU5 - Mandatory exercise 5 for the "Datastructures and algorithms" course at
@@ -23,6 +32,23 @@
  *
  * Version information:
  *   v1.0  2020-06-05: First public version.
+ *   v1.1  2026-10-17: find_path() traverses the CSR representation of the
+ * 		       graph by node id.
+ *   v1.2  2026-10-17: find_path() keeps its seen status in a graph_visit 
+ * 		       object that is reset in constant time.
+ *   v1.3  2026-10-17: Added bidirectional search, option -b.
+ *   v1.4  2026-10-17: Added the SCC reachability index, option -s.
+ *   v1.5  2026-10-17: Added the query cache, option -c.
+ *   v1.6  2026-10-17: Added batch mode, option -q.
+ *   v1.7  2026-10-17: Batch mode answers questions in several threads, 
+ * 		       option -j.
+ *   v1.8  2026-10-17: The map file is loaded by mapfile_load(). Fixed the
+ * 		       size of the name buffers of the interactive loop.
+ *   v1.9  2026-10-17: Added option -d, repeated edges in the map file are
+ * 		       only inserted once.
+ *   v2.0  2026-10-17: Added options -p and -w, the shortest path is printed
+ * 		       with each answer.
+ *   v2.1  2026-10-17: populate_graph() also loads binary graph images.
 */
 
 // ==========================================================================
@@ -73,117 +99,65 @@ bool line_is_comment(const char *s)
         return (i >= 0 && s[i] == '#');
 }
 
+/**
+ * copy_label() - Create a dynamic copy of a node name.
+ * @s: Null-terminated string to be copied.
+ *
+ * Returns: Pointer to the copy, to be freed by the caller.
+ */
+static char *copy_label(const char *s)
+{
+	char *copy = malloc(strlen(s) + 1);
+	strcpy(copy, s);
+	return copy;
+}
+
 /**
  * populate_graph() - Create and populate a new graph according to file.
  * @filename: A string containing the file name of the map file to open.
+ * @unique_edges: If true, repeated edges are only inserted once.
+ *
+ * A map file is memory-mapped and scanned in one pass, see mapfile.h. A 
+ * binary image made by map2bin is recognized by its first bytes and mapped
+ * without parsing, see graph_load_binary().
  *
  * Returns: Pointer to a new and populated graph.
  */
-graph *populate_graph(const char *filename)
+graph *populate_graph(const char *filename, bool unique_edges)
 {
-	// Allocate a file pointer and open the input file.
-	FILE *in = fopen(filename, "r");
-	if (in == NULL) {
-		fprintf(stderr, "FAIL: Could not open the input file %s: %s\n", 
-			filename, strerror(errno));
+	if (!graph_is_binary(filename)) {
+		return mapfile_load(filename, unique_edges);
+	}
+	graph *g = graph_load_binary(filename);
+	if (g == NULL) {
+		fprintf(stderr, "FAIL: Could not load the graph image %s: %s\n",
+			filename, errno == EINVAL 
+			? "Invalid image or made on another kind of host" 
+			: strerror(errno));
 		exit(EXIT_FAILURE);
-	} 
-
-	/* Allocation of graph pointer, int for edge count, string buffers and 
-	   flag for first line in file.	*/ 
-	graph *g;
-	int nr_edges;
-	char line[BUFSIZE];
-	char src_str[40];
-	char dst_str[40];
-	bool is_first_line = true;	 
-
-	/* Read line from input file and repeat until end-of-file is reached.
-	   Extract the integer from the first non-blank and non-comment line, 
-	   signifying the number of edges to insert. Create a graph with 
-	   max_nodes set to 2 times this value, to cover for the extreme case. 
-	   For each following line, insert each pair of nodes and the 
-	   corresponding edges into the graph. */
-	while (fgets(line, BUFSIZE, in)!= NULL) {
-		// Ignore blank lines and comment lines.
-		if (line_is_blank(line) || line_is_comment(line)) {
-                        continue;
-                }
-
-		// Single out the first non-comment, non-blank line.
-		if (is_first_line){
-			// Extract integer.
-			int out = sscanf(line,"%d", &nr_edges);
-			
-			// Verify successful read by sscanf.
-			if (out == EOF || out == 0) {
-				fprintf(stderr, "FAIL: Incorrect map format. "
-				        "Expected integer on first non-comment,"
-					" non-blank line.\n");
-				exit(EXIT_FAILURE);
-			}
-
-			// Create graph.
-			g = graph_empty(2*nr_edges);
-			
-			// Flag that we have passed the first line of interest.
-			is_first_line = false;
-		} else {
-			// Set first char to NULL in both string buffers. 
-			src_str[0] = 0;
-			dst_str[0] = 0;
-
-			/* Extract the pair of nodes from the current line. Each
-			   node label is a string of max 40 chars, separated by 
-			   whitespace.	*/
-			int out = sscanf(line, "%40s %40s", src_str, dst_str);
-			
-			// Verify successful read by sscanf.
-			if (out == EOF) {
-				fprintf(stderr, "FAIL: Could not interpret map "
-				       "contents: %s.\n", strerror(errno));
-				exit(EXIT_FAILURE);
-			}
-			
-			// Verify that both strings have been written to.
-			if (src_str[0] == 0 || dst_str[0] == 0) {
-				fprintf(stderr, "FAIL: Incorrect map format. "
-				        "Expected two alphanumeric node names "
-					"on each line.\n");
-				exit(EXIT_FAILURE);
-			}
-
-			// Insert the nodes into the graph.
-			graph_insert_node(g, src_str);
-			graph_insert_node(g, dst_str);
-			
-			// Get the posititons of the recently inserted nodes. 
-			node *src = graph_find_node(g, src_str);
-			node *dst = graph_find_node(g, dst_str);
-
-			// Insert the edge into the graph.
-			graph_insert_edge(g, src, dst);
-		}
 	}
-
-	// Close the input file.
-	if (fclose(in)) {
-                fprintf(stderr, "FAIL: Could not close the input file %s: %s\n",
-		        filename, strerror(errno));
-                exit(EXIT_FAILURE);
-        }
+	if (unique_edges) {
+		graph_unique_edges(g);
+	}
 	return g;
 }
 
 /** find_path() - Answers the question whether or not there is a path from the 
  * 		  source node to the destination node.
- * @g: Pointer to the graph to be traversed.
+ * @g: Pointer to the frozen graph to be traversed, see graph_freeze().
+ * @visit: Visit object for the graph, reset at the start of the search.
  * @src: Pointer to the source node.
  * @dest: Pointer to the destination node.
+ * @queue: Array of at least nr_of_nodes elements, used as the queue of the
+ * 	   search.
  * 
+ * The graph is traversed breadth-first over its CSR representation, with the
+ * nodes identified by their integer ids.
+ *
  * Returns: True if there is a path from the source to the destination node.
  */
-bool find_path(graph *g, node *src, node *dest)
+bool find_path(graph *g, graph_visit *visit, node *src, node *dest, 
+	       int *queue)
 {	
 	// Check if source and destination nodes are the same.
 	if (nodes_are_equal(src, dest)) {
@@ -191,96 +165,730 @@ bool find_path(graph *g, node *src, node *dest)
 		return true;
 	}
 
-	/* Create a new and empty queue. Note: The freeing function must be set 
-	   to NULL in order to not mistakingly remove any node from the graph on
-	   dequeing. */
-	queue *q = queue_empty(NULL);
-	// Mark node as seen.
-	graph_node_set_seen(g, src, true);
-	// Place node in queue.
-	q = queue_enqueue(q, src);
+	const csr *c = graph_csr(g);
+	int s = graph_node_id(g, src);
+	int d = graph_node_id(g, dest);
+
+	/* Start a new visit, which takes constant time. Each node is enqueued 
+	   at most once, so the queue never holds more than nr_of_nodes ids. */
+	graph_visit_reset(visit);
+	int head = 0;
+	int tail = 0;
+
+	// Mark the source node as seen and place it in the queue.
+	graph_visit_set_seen(visit, s);
+	queue[tail++] = s;
 
-	// Allocate node and dlist pointers. 
-	node *n;
-	node *n_current;
-	dlist *neighbour_list;
 	// Flag to indicate that a path has been found.
 	bool path_exists = false;
 
 	/* Traverse the graph breadth-first from the source node. If the 
 	   destination node is found, the two nodes are connected and an answer
 	   to the question is found. */
-	while (!queue_is_empty(q)) {
+	while (head < tail && !path_exists) {
 		// Pick and dequeue the first node in the queue.
-		n = queue_front(q);
-		q = queue_dequeue(q);
-
-		// Fetch a list of the neighbours.
-		neighbour_list = graph_neighbours(g, n);
-
-		/* Inspect each neighbour in the list, mark as seen and add to 
-		   the queue if not already visited. */
-		dlist_pos pos = dlist_first(neighbour_list);
-		while (!dlist_is_end(neighbour_list, pos)) {
-			/* Inspect the string label and fetch the corresponding 
-			   node pointer. */
-			const char *s = dlist_inspect(neighbour_list, pos);
-			n_current = graph_find_node(g, s);
-
-			// Check if node has been seen before.
-			if (!graph_node_is_seen(g, n_current)){
-				/* Node has not already been seen. Mark as seen
-				   and place in the queue. */
-				graph_node_set_seen(g, n_current, true);
-				q = queue_enqueue(q, n_current);
-				
+		int v = queue[head++];
+
+		/* Inspect each neighbour, mark as seen and add to the queue if
+		   not already visited. */
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			if (!graph_visit_is_seen(visit, w)) {
+				graph_visit_set_seen(visit, w);
+				queue[tail++] = w;
+
 				// Check if current node is the destination node.
-				if (nodes_are_equal(n_current, dest)) {
-					// We have reached the destination node.
+				if (w == d) {
 					path_exists = true;
 					break;
 				}
 			}
-			// Traverse the list to the next neighbour.
-			pos = dlist_next(neighbour_list, pos);
 		}
-		// Destroy the list.
-		dlist_kill(neighbour_list);
+	}
+
+	// Return the answer to the question.
+	return path_exists; 
+}
+
+/**
+ * expand_level() - Expand one level of a breadth-first search.
+ * @c: CSR structure with the edges to follow.
+ * @queue: Queue of node ids. The level to expand is queue[*head], ..., 
+ * 	   queue[*tail-1].
+ * @head: Pointer to the start of the level in the queue.
+ * @tail: Pointer to the end of the queue.
+ * @own: Visit object of this search direction.
+ * @other: Visit object of the opposite search direction.
+ *
+ * All nodes of the level are dequeued and their unseen neighbours are marked
+ * and enqueued, forming the next level.
+ *
+ * Returns: True if a node seen by the opposite direction was reached.
+ */
+static bool expand_level(const csr *c, int *queue, int *head, int *tail,
+			 graph_visit *own, const graph_visit *other)
+{
+	int end = *tail;
+	while (*head < end) {
+		int v = queue[(*head)++];
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			if (graph_visit_is_seen(other, w)) {
+				// The two searches have met.
+				return true;
+			}
+			if (!graph_visit_is_seen(own, w)) {
+				graph_visit_set_seen(own, w);
+				queue[(*tail)++] = w;
+			}
+		}
+	}
+	return false;
+}
+
+/** find_path_bidirectional() - Answers the question whether or not there is a 
+ * 				path from the source node to the destination
+ * 				node, searching from both ends.
+ * @g: Pointer to the frozen graph to be traversed, see graph_freeze().
+ * @fwd: Visit object for the forward search, from the source node.
+ * @bwd: Visit object for the backward search, from the destination node.
+ * @src: Pointer to the source node.
+ * @dest: Pointer to the destination node.
+ * @fwd_queue: Array of at least nr_of_nodes elements, used as the queue of
+ * 	       the forward search.
+ * @bwd_queue: Array of at least nr_of_nodes elements, used as the queue of
+ * 	       the backward search.
+ *
+ * A forward search follows the out-edges from the source node and a backward
+ * search follows the in-edges from the destination node. In each step, the 
+ * search with the smaller frontier expands one full level. There is a path
+ * as soon as one search reaches a node seen by the other, and no path when
+ * either search runs out of nodes. Gives the same answer as find_path().
+ *
+ * Returns: True if there is a path from the source to the destination node.
+ */
+bool find_path_bidirectional(graph *g, graph_visit *fwd, graph_visit *bwd,
+			     node *src, node *dest, int *fwd_queue, 
+			     int *bwd_queue)
+{
+	// Check if source and destination nodes are the same.
+	if (nodes_are_equal(src, dest)) {
+		// Source and destination are the same node, always a path.
+		return true;
+	}
+
+	const csr *c_out = graph_csr(g);
+	const csr *c_in = graph_csr_in(g);
+
+	// Start a new visit in each direction.
+	graph_visit_reset(fwd);
+	graph_visit_reset(bwd);
+	int fwd_head = 0;
+	int fwd_tail = 0;
+	int bwd_head = 0;
+	int bwd_tail = 0;
+
+	graph_visit_set_seen(fwd, graph_node_id(g, src));
+	fwd_queue[fwd_tail++] = graph_node_id(g, src);
+	graph_visit_set_seen(bwd, graph_node_id(g, dest));
+	bwd_queue[bwd_tail++] = graph_node_id(g, dest);
+
+	bool path_exists = false;
+	while (!path_exists && fwd_head < fwd_tail && bwd_head < bwd_tail) {
+		// Expand the side with the smaller frontier.
+		if (fwd_tail - fwd_head <= bwd_tail - bwd_head) {
+			path_exists = expand_level(c_out, fwd_queue, &fwd_head,
+						   &fwd_tail, fwd, bwd);
+		} else {
+			path_exists = expand_level(c_in, bwd_queue, &bwd_head,
+						   &bwd_tail, bwd, fwd);
+		}
+	}
+
+	return path_exists;
+}
+
+/** reach_all() - Find all nodes reachable from a node.
+ * @g: Pointer to the frozen graph to be traversed, see graph_freeze().
+ * @visit: Visit object for the graph, reset at the start of the search.
+ * @src: Id of the source node.
+ * @queue: Array of at least nr_of_nodes elements, where the ids of the 
+ * 	   reached nodes are stored.
+ *
+ * Breadth-first search from the source node, run until all reachable nodes
+ * have been seen. Afterwards, visit tells which nodes are reachable.
+ *
+ * Returns: The number of reached nodes, including the source node.
+ */
+int reach_all(graph *g, graph_visit *visit, int src, int *queue)
+{
+	const csr *c = graph_csr(g);
+	int head = 0;
+	int tail = 0;
+
+	graph_visit_reset(visit);
+	graph_visit_set_seen(visit, src);
+	queue[tail++] = src;
+	while (head < tail) {
+		int v = queue[head++];
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			if (!graph_visit_is_seen(visit, w)) {
+				graph_visit_set_seen(visit, w);
+				queue[tail++] = w;
+			}
+		}
+	}
+	return tail;
+}
+
+// What to print about the path of a positive answer.
+enum path_mode {
+	PATH_NONE,	// Only that there is a path.
+	PATH_HOPS,	// The path with the fewest edges.
+	PATH_WEIGHTED,	// The path with the smallest total weight.
+};
+
+// Everything needed to answer questions about one graph.
+struct path_finder {
+	graph *g;
+	graph_visit *fwd;	// Visit object for the forward search.
+	graph_visit *bwd;	// Visit object for the backward search.
+	scc_index *scc;		// Reachability index, or NULL.
+	query_cache *cache;	// Cache of answers, or NULL.
+	int *queue;		// Queue for find_path() and reach_all().
+	int *bwd_queue;		// Queue for the backward search, or NULL.
+	bool bidirectional;
+	enum path_mode path_mode;
+	path_search *ps;	// Search state for the paths, or NULL.
+	int *path;		// Node ids of the last path found.
+};
+
+/**
+ * print_answer() - Print the answer to a question, without newline.
+ * @pf: Path finder set up for the graph.
+ * @s: Id of the source node.
+ * @d: Id of the destination node.
+ * @path_exists: True if there is a path from s to d.
+ *
+ * If the path finder is asked for paths, the shortest path from s to d is
+ * printed along with the answer, with its number of edges or its weight.
+ *
+ * Returns: Nothing.
+ */
+static void print_answer(struct path_finder *pf, int s, int d, 
+			 bool path_exists)
+{
+	const char *src = graph_node_label(pf->g, graph_node_from_id(pf->g, s));
+	const char *dst = graph_node_label(pf->g, graph_node_from_id(pf->g, d));
+	if (!path_exists) {
+		printf("There is no path from %s to %s.", src, dst);
+		return;
+	}
+	if (pf->path_mode == PATH_NONE) {
+		printf("There is a path from %s to %s.", src, dst);
+		return;
+	}
+
+	int nr_in_path;
+	double length;
+	if (pf->path_mode == PATH_HOPS) {
+		length = graph_shortest_path(pf->ps, s, d, pf->path);
+		nr_in_path = (int)length + 1;
+	} else {
+		length = graph_weighted_shortest_path(pf->ps, s, d, pf->path,
+						      &nr_in_path);
+	}
+	printf("There is a path from %s to %s:", src, dst);
+	for (int i = 0; i < nr_in_path; i++) {
+		printf("%s %s", i > 0 ? " ->" : "", 
+		       graph_node_label(pf->g, 
+				graph_node_from_id(pf->g, pf->path[i])));
+	}
+	if (pf->path_mode == PATH_HOPS) {
+		printf(" (%d %s).", nr_in_path - 1, 
+		       nr_in_path == 2 ? "hop" : "hops");
+	} else {
+		printf(" (length %g).", length);
+	}
+}
+
+/** answer_question() - Answers the question whether or not there is a path 
+ * 			from the source node to the destination node.
+ * @pf: Path finder set up for the graph.
+ * @src: Pointer to the source node.
+ * @dest: Pointer to the destination node.
+ *
+ * Uses the reachability index if there is one, otherwise a bidirectional or
+ * a one-sided search. With a cache, cached answers are used first. On a 
+ * cache miss without an index, the search from the source node is run to 
+ * the end, so the set of reachable nodes can be cached for later questions
+ * from the same source node.
+ *
+ * Returns: True if there is a path from the source to the destination node.
+ */
+bool answer_question(struct path_finder *pf, node *src, node *dest)
+{
+	int s = graph_node_id(pf->g, src);
+	int d = graph_node_id(pf->g, dest);
+	bool path_exists;
+
+	if (pf->cache != NULL) {
+		if (query_cache_lookup(pf->cache, s, d, &path_exists)) {
+			return path_exists;
+		}
+		if (pf->scc != NULL) {
+			path_exists = scc_index_reachable(pf->scc, s, d);
+		} else {
+			int nr_reached = reach_all(pf->g, pf->fwd, s, 
+						   pf->queue);
+			query_cache_store_reachable(pf->cache, s, pf->queue,
+						    nr_reached);
+			path_exists = graph_visit_is_seen(pf->fwd, d);
+		}
+		query_cache_store(pf->cache, s, d, path_exists);
+		return path_exists;
+	}
+
+	if (pf->scc != NULL) {
+		return scc_index_reachable(pf->scc, s, d);
+	} else if (pf->bidirectional) {
+		return find_path_bidirectional(pf->g, pf->fwd, pf->bwd, src, 
+					       dest, pf->queue, pf->bwd_queue);
+	} else {
+		return find_path(pf->g, pf->fwd, src, dest, pf->queue);
+	}
+}
+
+// Outcome of reading a question in batch mode.
+enum question_status {
+	QUESTION_OK,
+	QUESTION_BAD_FORMAT,	// Not two node names on the line.
+	QUESTION_NO_SRC,	// Source node not in the graph.
+	QUESTION_NO_DST,	// Destination node not in the graph.
+};
+
+// A question read in batch mode.
+struct question {
+	enum question_status status;
+	int src;		// Id of the source node.
+	int dst;		// Id of the destination node.
+	char *missing;		// Copy of the name of a missing node, or NULL.
+	bool answer;
+};
 
-		// If the question has been answered, exit the while-loop.
-		if (path_exists) {
+/**
+ * read_questions() - Read all questions from a stream.
+ * @g: Graph that the questions are about.
+ * @in: Stream to read from.
+ * @nr_of_questions: Pointer to where the number of questions is stored.
+ *
+ * Each non-blank, non-comment line holds one question, the names of the 
+ * source and the destination node. Reading stops at end-of-file or at a
+ * line starting with quit.
+ *
+ * Returns: A dynamic array of questions, to be freed by the caller.
+ */
+struct question *read_questions(const graph *g, FILE *in, int *nr_of_questions)
+{
+	int capacity = 1024;
+	int n = 0;
+	struct question *questions = malloc(capacity * sizeof(struct question));
+	char line[BUFSIZE];
+	char src[41];
+	char dst[41];
+
+	while (fgets(line, BUFSIZE, in) != NULL) {
+		if (line_is_blank(line) || line_is_comment(line)) {
+			continue;
+		}
+		if (strncmp(line, "quit", 4) == 0) {
 			break;
 		}
+		if (n == capacity) {
+			capacity *= 2;
+			questions = realloc(questions, 
+					    capacity * sizeof(struct question));
+		}
+		struct question *q = &questions[n++];
+		q->missing = NULL;
+		q->answer = false;
+
+		src[0] = 0;
+		dst[0] = 0;
+		sscanf(line, "%40s %40s", src, dst);
+		if (src[0] == 0 || dst[0] == 0) {
+			q->status = QUESTION_BAD_FORMAT;
+			continue;
+		}
+		node *node_src = graph_find_node(g, src);
+		node *node_dst = graph_find_node(g, dst);
+		if (node_src == NULL) {
+			q->status = QUESTION_NO_SRC;
+			q->missing = copy_label(src);
+		} else if (node_dst == NULL) {
+			q->status = QUESTION_NO_DST;
+			q->missing = copy_label(dst);
+		} else {
+			q->status = QUESTION_OK;
+			q->src = graph_node_id(g, node_src);
+			q->dst = graph_node_id(g, node_dst);
+		}
 	}
-	// Destroy the queue. 
-	queue_kill(q);
+	*nr_of_questions = n;
+	return questions;
+}
 
-	// Reset the seen status of all nodes in the graph.
-	graph_reset_seen(g);
+// Questions of a batch, grouped by source node, shared by all threads.
+struct batch {
+	graph *g;
+	const scc_index *scc;		// Reachability index, or NULL.
+	struct question *questions;
+	const csr *by_source;		// Question numbers for each source id.
+	const int *origins;		// Distinct source ids.
+	int nr_of_origins;
+	int next_origin;		// First origin not yet taken by a thread.
+	pthread_mutex_t lock;		// Protects next_origin.
+};
+
+// Search state of one thread in batch mode.
+struct batch_worker {
+	struct batch *b;
+	graph_visit *visit;
+	scc_scratch *scratch;		// Search state for the index, or NULL.
+	int *queue;
+	pthread_t thread;
+};
 
-	// Return the answer to the question.
-	return path_exists; 
+/**
+ * answer_origin() - Answer all questions from one source node.
+ * @w: Thread state to use.
+ * @s: Id of the source node.
+ *
+ * Returns: Nothing.
+ */
+static void answer_origin(struct batch_worker *w, int s)
+{
+	struct batch *b = w->b;
+	int first = b->by_source->offsets[s];
+	int end = b->by_source->offsets[s + 1];
+
+	if (b->scc == NULL) {
+		reach_all(b->g, w->visit, s, w->queue);
+	}
+	for (int i = first; i < end; i++) {
+		struct question *q = &b->questions[b->by_source->targets[i]];
+		if (b->scc != NULL) {
+			q->answer = scc_index_reachable_r(b->scc, w->scratch, s,
+							  q->dst);
+		} else {
+			q->answer = graph_visit_is_seen(w->visit, q->dst);
+		}
+	}
 }
 
+/**
+ * batch_work() - Thread function that answers questions of a batch.
+ * @arg: Pointer to the struct batch_worker of the thread.
+ *
+ * Takes BATCH_CHUNK origins at a time from the shared batch until all 
+ * origins are taken. Only the answers of the questions from the taken 
+ * origins are written, so the threads never write the same memory.
+ *
+ * Returns: NULL.
+ */
+static void *batch_work(void *arg)
+{
+	struct batch_worker *w = arg;
+	struct batch *b = w->b;
+
+	while (true) {
+		pthread_mutex_lock(&b->lock);
+		int first = b->next_origin;
+		b->next_origin += BATCH_CHUNK;
+		pthread_mutex_unlock(&b->lock);
+
+		if (first >= b->nr_of_origins) {
+			return NULL;
+		}
+		int end = first + BATCH_CHUNK;
+		if (end > b->nr_of_origins) {
+			end = b->nr_of_origins;
+		}
+		for (int i = first; i < end; i++) {
+			answer_origin(w, b->origins[i]);
+		}
+	}
+}
+
+/**
+ * run_batch() - Answer all questions from a stream.
+ * @pf: Path finder set up for the graph.
+ * @in: Stream with one question per line, see read_questions().
+ * @nr_of_threads: Number of threads to answer the questions with.
+ *
+ * All questions are read first and grouped by source node. For each 
+ * distinct source node, a single search is run to the end, which answers 
+ * all questions from that node. The source nodes are shared between the
+ * threads, each with its own visit object and queue; the graph and the 
+ * index are only read. The answers are printed in the order of the 
+ * questions, one line each. Paths asked for by the path finder are found
+ * while printing, in the calling thread.
+ *
+ * Returns: Nothing.
+ */
+void run_batch(struct path_finder *pf, FILE *in, int nr_of_threads)
+{
+	int n;
+	struct question *questions = read_questions(pf->g, in, &n);
+
+	// Group the valid questions by source node with a counting sort.
+	int *srcs = malloc((n > 0 ? n : 1) * sizeof(int));
+	int *ids = malloc((n > 0 ? n : 1) * sizeof(int));
+	int m = 0;
+	for (int i = 0; i < n; i++) {
+		if (questions[i].status == QUESTION_OK) {
+			srcs[m] = questions[i].src;
+			ids[m] = i;
+			m++;
+		}
+	}
+	csr *by_source = csr_build(graph_nr_of_nodes(pf->g), m, srcs, ids);
+	free(srcs);
+	free(ids);
+
+	// List the distinct source nodes.
+	int *origins = malloc((m > 0 ? m : 1) * sizeof(int));
+	int nr_of_origins = 0;
+	for (int s = 0; s < by_source->nr_of_nodes; s++) {
+		if (by_source->offsets[s] < by_source->offsets[s + 1]) {
+			origins[nr_of_origins++] = s;
+		}
+	}
+
+	// One search per distinct source node, shared between the threads.
+	struct batch b;
+	b.g = pf->g;
+	b.scc = pf->scc;
+	b.questions = questions;
+	b.by_source = by_source;
+	b.origins = origins;
+	b.nr_of_origins = nr_of_origins;
+	b.next_origin = 0;
+	pthread_mutex_init(&b.lock, NULL);
+
+	if (nr_of_threads > nr_of_origins) {
+		nr_of_threads = nr_of_origins > 0 ? nr_of_origins : 1;
+	}
+	struct batch_worker *workers = malloc(nr_of_threads 
+					      * sizeof(struct batch_worker));
+	for (int t = 0; t < nr_of_threads; t++) {
+		struct batch_worker *w = &workers[t];
+		w->b = &b;
+		if (t == 0) {
+			// The calling thread uses the path finder's state.
+			w->visit = pf->fwd;
+			w->queue = pf->queue;
+		} else {
+			w->visit = graph_visit_new(pf->g);
+			w->queue = malloc((graph_nr_of_nodes(pf->g) + 1) 
+					  * sizeof(int));
+		}
+		w->scratch = NULL;
+		if (pf->scc != NULL) {
+			w->scratch = scc_scratch_new(pf->scc);
+		}
+	}
+	for (int t = 1; t < nr_of_threads; t++) {
+		// pthread_create() returns the error code, errno is not set.
+		int err = pthread_create(&workers[t].thread, NULL, batch_work,
+					 &workers[t]);
+		if (err != 0) {
+			fprintf(stderr, "FAIL: Could not create thread: %s\n",
+				strerror(err));
+			exit(EXIT_FAILURE);
+		}
+	}
+	batch_work(&workers[0]);
+	for (int t = 0; t < nr_of_threads; t++) {
+		struct batch_worker *w = &workers[t];
+		if (t > 0) {
+			pthread_join(w->thread, NULL);
+			graph_visit_kill(w->visit);
+			free(w->queue);
+		}
+		if (w->scratch != NULL) {
+			scc_scratch_kill(w->scratch);
+		}
+	}
+	free(workers);
+	pthread_mutex_destroy(&b.lock);
+	free(origins);
+	csr_kill(by_source);
+
+	// Print the answers in the original order.
+	for (int i = 0; i < n; i++) {
+		struct question *q = &questions[i];
+		switch (q->status) {
+		case QUESTION_BAD_FORMAT:
+			printf("Please enter two nodes, separated by " 
+			       "whitespace.\n");
+			break;
+		case QUESTION_NO_SRC:
+		case QUESTION_NO_DST:
+			printf("Node %s not found. Please input an existing "
+			       "node.\n", q->missing);
+			free(q->missing);
+			break;
+		case QUESTION_OK:
+			print_answer(pf, q->src, q->dst, q->answer);
+			printf("\n");
+			break;
+		}
+	}
+	free(questions);
+}
+
+/**
+ * print_usage() - Print the command line syntax to stderr.
+ * @name: Name of the program.
+ *
+ * Returns: Nothing.
+ */
+static void print_usage(const char *name)
+{
+	fprintf(stderr, "Useage: %s [-b] [-s] [-c] [-d] [-p | -w] "
+			"[-q questions [-j n]] filename\n"
+			"\twhere filename is a map file containing a directed "
+			"graph structure,\n\tor a binary image of one made "
+			"by map2bin.\n\n"
+			"\tUse -b to search from both ends of each path "
+			"(bidirectional search).\n"
+			"\tUse -s to answer from a precomputed index of the "
+			"strongly connected\n\tcomponents.\n"
+			"\tUse -c to cache answers and reachable sets for "
+			"repeated questions.\n"
+			"\tUse -d to insert repeated edges of the map file "
+			"only once.\n"
+			"\tUse -p to print the path with the fewest edges "
+			"with each answer.\n"
+			"\tUse -w to print the path with the smallest total "
+			"edge weight with each\n\tanswer.\n"
+			"\tUse -q to answer all questions in the file "
+			"questions (- for stdin)\n\tin batch mode, one "
+			"search per distinct origin.\n"
+			"\tUse -j to answer the questions in batch mode with "
+			"n threads, only\n\tallowed together with -q.\n", name);
+}
 
 int main(int argc, char **argv)
 {
-	// Verify the number of input arguments.
-	if (argc <= 1) {
-		fprintf(stderr, "Useage: filename\n\twhere filename is a map "
-				"file containing a directed graph structure.\n");
+	// Parse the options and verify the number of input arguments.
+	bool bidirectional = false;
+	bool use_scc = false;
+	bool use_cache = false;
+	bool unique_edges = false;
+	enum path_mode path_mode = PATH_NONE;
+	const char *batch_file = NULL;
+	int nr_of_threads = 1;
+	bool threads_given = false;
+	int argi = 1;
+	while (argi < argc && argv[argi][0] == '-') {
+		if (strcmp(argv[argi], "-b") == 0) {
+			bidirectional = true;
+		} else if (strcmp(argv[argi], "-s") == 0) {
+			use_scc = true;
+		} else if (strcmp(argv[argi], "-c") == 0) {
+			use_cache = true;
+		} else if (strcmp(argv[argi], "-d") == 0) {
+			unique_edges = true;
+		} else if (strcmp(argv[argi], "-p") == 0 
+			   && path_mode != PATH_WEIGHTED) {
+			path_mode = PATH_HOPS;
+		} else if (strcmp(argv[argi], "-w") == 0
+			   && path_mode != PATH_HOPS) {
+			path_mode = PATH_WEIGHTED;
+		} else if (strcmp(argv[argi], "-q") == 0 && argi + 1 < argc) {
+			batch_file = argv[++argi];
+		} else if (strcmp(argv[argi], "-j") == 0 && argi + 1 < argc) {
+			nr_of_threads = atoi(argv[++argi]);
+			threads_given = true;
+			if (nr_of_threads < 1 || nr_of_threads > MAX_THREADS) {
+				fprintf(stderr, "FAIL: The number of threads "
+					"must be between 1 and %d.\n", 
+					MAX_THREADS);
+				return -1;
+			}
+		} else {
+			print_usage(argv[0]);
+			return -1;
+		}
+		argi++;
+	}
+	if (argi != argc - 1 || (threads_given && batch_file == NULL)) {
+		print_usage(argv[0]);
 		return -1;
 	} 
 	
 	// Create and populate graph according to file.
-	const char *filename = argv[1];
-	graph *g = populate_graph(filename);
+	const char *filename = argv[argi];
+	graph *g = populate_graph(filename, unique_edges);
+
+	// Pack the edges for fast traversal. The graph is not modified below.
+	graph_freeze(g);
+	struct path_finder pf;
+	pf.g = g;
+	pf.fwd = graph_visit_new(g);
+	pf.bwd = graph_visit_new(g);
+	pf.bidirectional = bidirectional;
+	pf.queue = malloc((graph_nr_of_nodes(g) + 1) * sizeof(int));
+	pf.bwd_queue = NULL;
+	if (bidirectional) {
+		pf.bwd_queue = malloc((graph_nr_of_nodes(g) + 1) * sizeof(int));
+	}
+	pf.path_mode = path_mode;
+	pf.ps = NULL;
+	pf.path = NULL;
+	if (path_mode != PATH_NONE) {
+		pf.ps = path_search_new(g);
+		pf.path = malloc((graph_nr_of_nodes(g) + 1) * sizeof(int));
+	}
+
+	// Build the reachability index and the cache once, if asked for.
+	pf.scc = NULL;
+	if (use_scc) {
+		pf.scc = scc_index_build(graph_csr(g));
+	}
+	pf.cache = NULL;
+	if (use_cache) {
+		pf.cache = query_cache_new(g, CACHE_PAIRS, CACHE_SOURCES);
+	}
 	
+	bool running = true;
+
+	// In batch mode, answer all questions and exit.
+	if (batch_file != NULL) {
+		FILE *in = stdin;
+		if (strcmp(batch_file, "-") != 0) {
+			in = fopen(batch_file, "r");
+			if (in == NULL) {
+				fprintf(stderr, "FAIL: Could not open the "
+					"question file %s: %s\n", batch_file, 
+					strerror(errno));
+				exit(EXIT_FAILURE);
+			}
+		}
+		run_batch(&pf, in, nr_of_threads);
+		if (in != stdin) {
+			fclose(in);
+		}
+		running = false;
+	}
+
 	// Allocate string buffers and test flags.
 	char str[256];
-	char src[40];
-	char dst[40];
-	bool running = true;
+	char src[41];
+	char dst[41];
 	bool path_test;
 	
 	/* While the user has not chosen to exit the program, ask for two nodes
@@ -331,19 +939,31 @@ int main(int argc, char **argv)
 			}
 			
 			/* Perform connectivity test and print the result. */
-			path_test = find_path(g, node_src, node_dst);
-			if (path_test) {
-				printf("There is a path from %s to %s.\n\n", 
-					src, dst);
-			} else {
-				printf("There is no path from %s to %s.\n\n", 
-					src, dst);
-			}	
+			path_test = answer_question(&pf, node_src, node_dst);
+			print_answer(&pf, graph_node_id(g, node_src), 
+				     graph_node_id(g, node_dst), path_test);
+			printf("\n\n");
 		}
 	}
 
-	// Destroy the graph. 
+	// Destroy the visit object and the graph. 
+	graph_visit_kill(pf.fwd);
+	graph_visit_kill(pf.bwd);
+	free(pf.queue);
+	free(pf.bwd_queue);
+	if (pf.ps != NULL) {
+		path_search_kill(pf.ps);
+		free(pf.path);
+	}
+	if (pf.scc != NULL) {
+		scc_index_kill(pf.scc);
+	}
+	if (pf.cache != NULL) {
+		query_cache_kill(pf.cache);
+	}
 	graph_kill(g);
-	printf("Normal exit.\n");
+	if (batch_file == NULL) {
+		printf("Normal exit.\n");
+	}
 	return 0;
 }
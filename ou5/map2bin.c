@@ -0,0 +1,59 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+
+#include "graph.h"
+#include "mapfile.h"
+
+/*
+ * Converter from map files to binary graph images for OU5. The map file is
+ * loaded as by is_connected and saved with graph_save_binary(). is_connected
+ * recognizes the image by its first bytes and loads it without parsing, 
+ * see graph_load_binary().
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+/**
+ * print_usage() - Print the command line syntax to stderr.
+ * @name: Name of the program.
+ *
+ * Returns: Nothing.
+ */
+static void print_usage(const char *name)
+{
+	fprintf(stderr, "Useage: %s [-d] mapfile imagefile\n"
+			"\tConverts the map file to a binary image, which "
+			"is_connected loads\n\twithout parsing.\n"
+			"\tUse -d to insert repeated edges of the map file "
+			"only once.\n", name);
+}
+
+int main(int argc, char **argv)
+{
+	bool unique_edges = false;
+	int argi = 1;
+	if (argi < argc && strcmp(argv[argi], "-d") == 0) {
+		unique_edges = true;
+		argi++;
+	}
+	if (argi != argc - 2) {
+		print_usage(argv[0]);
+		return -1;
+	}
+
+	graph *g = mapfile_load(argv[argi], unique_edges);
+	if (!graph_save_binary(g, argv[argi + 1])) {
+		fprintf(stderr, "FAIL: Could not write the graph image "
+			"%s: %s\n", argv[argi + 1], strerror(errno));
+		graph_kill(g);
+		return -1;
+	}
+	graph_kill(g);
+	return 0;
+}
@@ -0,0 +1,324 @@
+#define _POSIX_C_SOURCE 200112L	// For posix_madvise().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "mapfile.h"
+
+/*
+ * Implementation of the map file loader for OU5, see mapfile.h. The scanner
+ * works on the whole file contents as one array of characters. Each line is
+ * found with memchr() and split into names by hand, and each name is copied
+ * once into a small buffer to be interned in the graph.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Added unique_edges to mapfile_load().
+ *   v1.2  2026-10-17: The graph is not sized from the number of edges.
+ *   v1.3  2026-10-17: An optional third column holds the edge weight.
+ *   v1.4  2026-10-17: Room for nodes is reserved from the number of edges.
+ *   v1.5  2026-10-17: Only a comment may follow the edge weight.
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+// Size of the blocks read from files that cannot be mapped.
+#define READ_BLOCK 65536
+
+// Max number of characters in an edge weight.
+#define MAX_WEIGHT 40
+
+// Max number of nodes reserved from the number of edges given in the file.
+#define MAX_RESERVE (1 << 20)
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+// Contents of a map file in memory.
+struct contents {
+	char *data;
+	size_t size;
+	bool mapped;	// True if data is mapped, false if allocated.
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * fail() - Print an error message about a map file and exit.
+ * @msg: Message to print.
+ *
+ * Returns: Never.
+ */
+static void fail(const char *msg)
+{
+	fprintf(stderr, "FAIL: %s\n", msg);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * is_space() - Check if a character is whitespace, other than newline.
+ * @c: Character to check.
+ *
+ * Returns: True if c is a space, tab, carriage return, vertical tab or form
+ * 	    feed.
+ */
+static bool is_space(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * skip_space() - Skip whitespace within a line.
+ * @p: Position to start at.
+ * @end: End of the line.
+ *
+ * Returns: The position of the first non-whitespace character, or end.
+ */
+static const char *skip_space(const char *p, const char *end)
+{
+	while (p < end && is_space(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/**
+ * skip_word() - Skip a name within a line.
+ * @p: Position of the first character of the name.
+ * @end: End of the line.
+ *
+ * Returns: The position after the last character of the name.
+ */
+static const char *skip_word(const char *p, const char *end)
+{
+	while (p < end && !is_space(*p)) {
+		p++;
+	}
+	return p;
+}
+
+/**
+ * read_contents() - Read the contents of a file into memory.
+ * @filename: Name of the file.
+ * @c: Pointer to where the contents are stored.
+ *
+ * Regular files are mapped. Other files, and files that cannot be mapped,
+ * are read block by block into an allocated array.
+ *
+ * Returns: Nothing.
+ */
+static void read_contents(const char *filename, struct contents *c)
+{
+	int fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "FAIL: Could not open the input file %s: %s\n",
+			filename, strerror(errno));
+		exit(EXIT_FAILURE);
+	}
+	struct stat st;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+		void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd,
+			       0);
+		if (p != MAP_FAILED) {
+			// The file is scanned once from start to end.
+			posix_madvise(p, st.st_size, POSIX_MADV_SEQUENTIAL);
+			c->data = p;
+			c->size = st.st_size;
+			c->mapped = true;
+			close(fd);
+			return;
+		}
+	}
+
+	size_t capacity = READ_BLOCK;
+	c->data = malloc(capacity);
+	c->size = 0;
+	c->mapped = false;
+	while (true) {
+		if (c->size + READ_BLOCK > capacity) {
+			capacity *= 2;
+			c->data = realloc(c->data, capacity);
+		}
+		ssize_t n = read(fd, c->data + c->size, READ_BLOCK);
+		if (n < 0) {
+			fprintf(stderr, "FAIL: Could not read the input file "
+				"%s: %s\n", filename, strerror(errno));
+			exit(EXIT_FAILURE);
+		}
+		if (n == 0) {
+			break;
+		}
+		c->size += n;
+	}
+	close(fd);
+}
+
+/**
+ * parse_count() - Parse the number of edges at the start of a line.
+ * @p: Position of the first non-whitespace character of the line.
+ * @end: End of the line.
+ *
+ * Returns: The number of edges.
+ */
+static int parse_count(const char *p, const char *end)
+{
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+')) {
+		negative = *p == '-';
+		p++;
+	}
+	if (p == end || *p < '0' || *p > '9') {
+		fail("Incorrect map format. Expected integer on first "
+		     "non-comment, non-blank line.");
+	}
+	int count = 0;
+	while (p < end && *p >= '0' && *p <= '9') {
+		count = 10 * count + (*p - '0');
+		p++;
+	}
+	return negative ? -count : count;
+}
+
+/**
+ * intern_label() - Find or insert the node with a name from the file.
+ * @g: Graph to manipulate.
+ * @p: Position of the first character of the name.
+ * @end: Position after the last character of the name.
+ *
+ * Returns: A pointer to the node.
+ */
+static node *intern_label(graph *g, const char *p, const char *end)
+{
+	char label[MAPFILE_MAX_LABEL + 1];
+	size_t len = end - p;
+	if (len > MAPFILE_MAX_LABEL) {
+		fail("Incorrect map format. Node names are at most 40 "
+		     "characters long.");
+	}
+	memcpy(label, p, len);
+	label[len] = 0;
+	return graph_intern_node(g, label);
+}
+
+/**
+ * parse_weight() - Parse the weight of an edge.
+ * @p: Position of the first character of the weight.
+ * @end: Position after the last character of the weight.
+ *
+ * Returns: The weight, a finite non-negative number.
+ */
+static double parse_weight(const char *p, const char *end)
+{
+	char text[MAX_WEIGHT + 1];
+	size_t len = end - p;
+	if (len > MAX_WEIGHT) {
+		fail("Incorrect map format. Edge weights are at most 40 "
+		     "characters long.");
+	}
+	memcpy(text, p, len);
+	text[len] = 0;
+
+	char *rest;
+	double weight = strtod(text, &rest);
+	if (rest == text || *rest != 0 || !isfinite(weight) || weight < 0) {
+		fail("Incorrect map format. Expected a non-negative edge "
+		     "weight or a comment after the node names.");
+	}
+	return weight;
+}
+
+// =================== MAP FILE INTERFACE ======================
+
+/**
+ * mapfile_load() - Create and populate a new graph according to a map file.
+ * @filename: Name of the map file.
+ * @unique_edges: If true, repeated edges are only inserted once.
+ *
+ * Returns: Pointer to a new and populated graph.
+ */
+graph *mapfile_load(const char *filename, bool unique_edges)
+{
+	struct contents c;
+	read_contents(filename, &c);
+
+	graph *g = NULL;
+	const char *p = c.data;
+	const char *end = c.data + c.size;
+	while (p < end) {
+		const char *eol = memchr(p, '\n', end - p);
+		if (eol == NULL) {
+			eol = end;
+		}
+		// Ignore blank lines and comment lines.
+		const char *first = skip_space(p, eol);
+		if (first == eol || *first == '#') {
+			p = eol + 1;
+			continue;
+		}
+
+		if (g == NULL) {
+			/* The first line of interest holds the number of
+			   edges. It is only a hint, so at most MAX_RESERVE 
+			   nodes are reserved from it and the graph grows 
+			   beyond that as the nodes are inserted. */
+			int count = parse_count(first, eol);
+			if (count < 0) {
+				fail("Incorrect map format. The number of "
+				     "edges must not be negative.");
+			}
+			g = graph_empty(0);
+			graph_reserve(g, count < MAX_RESERVE / 2 ? 2 * count
+								 : MAX_RESERVE);
+			if (unique_edges) {
+				graph_unique_edges(g);
+			}
+		} else {
+			// The names of the source and the destination node.
+			const char *src_end = skip_word(first, eol);
+			const char *dst = skip_space(src_end, eol);
+			const char *dst_end = skip_word(dst, eol);
+			if (dst == eol) {
+				fail("Incorrect map format. Expected two "
+				     "alphanumeric node names on each line.");
+			}
+			/* An optional weight, unless the rest is a comment.
+			   Only a comment may follow the weight. */
+			const char *w = skip_space(dst_end, eol);
+			double weight = 1.0;
+			if (w < eol && *w != '#') {
+				const char *w_end = skip_word(w, eol);
+				weight = parse_weight(w, w_end);
+				const char *rest = skip_space(w_end, eol);
+				if (rest < eol && *rest != '#') {
+					fail("Incorrect map format. Expected a "
+					     "non-negative edge weight or a "
+					     "comment after the node names.");
+				}
+			}
+			node *n1 = intern_label(g, first, src_end);
+			node *n2 = intern_label(g, dst, dst_end);
+			graph_insert_weighted_edge(g, n1, n2, weight);
+		}
+		p = eol + 1;
+	}
+
+	if (c.mapped) {
+		munmap(c.data, c.size);
+	} else {
+		free(c.data);
+	}
+	if (g == NULL) {
+		fail("Incorrect map format. Expected integer on first "
+		     "non-comment, non-blank line.");
+	}
+	return g;
+}
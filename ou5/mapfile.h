@@ -0,0 +1,49 @@
+#ifndef __MAPFILE_H
+#define __MAPFILE_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/*
+ * Loader of map files for OU5. A map file holds the number of edges on the
+ * first non-blank, non-comment line, followed by one edge per line as the
+ * names of the source and the destination node, separated by whitespace.
+ * The names may be followed by the weight of the edge, a non-negative
+ * number of at most 40 characters. Edges without a weight have weight 1.
+ * Blank lines and lines starting with '#' are ignored, and a '#' after the
+ * names or the weight starts a comment.
+ *
+ * The file is memory-mapped and scanned once, without copying it into line
+ * buffers. Files that cannot be mapped, e.g. pipes, are read into memory
+ * first.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Added unique_edges to mapfile_load().
+ *   v1.3  2026-10-17: An optional third column holds the edge weight.
+ *   v1.5  2026-10-17: Only a comment may follow the edge weight.
+ */
+
+// ====================== PUBLIC CONSTANTS ==========================
+
+// Max number of characters in a node name.
+#define MAPFILE_MAX_LABEL 40
+
+// =================== MAP FILE INTERFACE ======================
+
+/**
+ * mapfile_load() - Create and populate a new graph according to a map file.
+ * @filename: Name of the map file.
+ * @unique_edges: If true, repeated edges are only inserted once, see
+ * 		  graph_unique_edges().
+ *
+ * Prints a message to stderr and exits the program if the file cannot be
+ * read or does not follow the map format.
+ *
+ * Returns: Pointer to a new and populated graph.
+ */
+graph *mapfile_load(const char *filename, bool unique_edges);
+
+#endif
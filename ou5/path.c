@@ -0,0 +1,352 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "path.h"
+
+/*
+ * Implementation of the shortest path searches for OU5, see path.h. A node
+ * has been reached by the current search if its stamp equals the current
+ * epoch, and only then are its distance and parent valid. The heap of
+ * Dijkstra's algorithm is 4-ary, which makes it shallower than a binary
+ * heap and keeps the children of a node in one cache line. Each node knows
+ * its position in the heap, so a shorter distance moves the node up in
+ * place instead of inserting it again.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+// Number of children of each node in the heap.
+#define HEAP_ARITY 4
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+struct path_search {
+	const csr *c;
+	int nr_of_nodes;
+	unsigned int epoch;	// Number of the current search.
+	unsigned int *stamps;	// Epoch when each node was reached.
+	int *parent;		// Previous node on the path, -1 for the source.
+	double *dist;		// Weight of the best path found so far.
+	int *queue;		// Queue of the search, or heap of node ids.
+	int *heap_pos;		// Position in the heap, -1 when done.
+	int heap_size;
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * start_search() - Start a new search.
+ * @ps: Search state to use.
+ *
+ * Returns: Nothing.
+ */
+static void start_search(path_search *ps)
+{
+	ps->epoch++;
+	if (ps->epoch == 0) {
+		// Counter wrapped, old stamps could match new epochs.
+		memset(ps->stamps, 0, ps->nr_of_nodes * sizeof(unsigned int));
+		ps->epoch = 1;
+	}
+}
+
+/**
+ * reach() - Mark a node as reached by the current search.
+ * @ps: Search state to use.
+ * @v: Id of the node.
+ * @parent: Id of the previous node on the path, or -1.
+ * @dist: Weight of the path.
+ *
+ * Returns: Nothing.
+ */
+static void reach(path_search *ps, int v, int parent, double dist)
+{
+	ps->stamps[v] = ps->epoch;
+	ps->parent[v] = parent;
+	ps->dist[v] = dist;
+}
+
+/**
+ * is_reached() - Check if a node has been reached by the current search.
+ * @ps: Search state to use.
+ * @v: Id of the node.
+ *
+ * Returns: True if v has been reached.
+ */
+static bool is_reached(const path_search *ps, int v)
+{
+	return ps->stamps[v] == ps->epoch;
+}
+
+/**
+ * trace_path() - Copy the path to a node, following the parents.
+ * @ps: Search state after a search that reached dst.
+ * @dst: Id of the last node of the path.
+ * @path: Array where the ids of the nodes on the path are stored, or NULL.
+ *
+ * Returns: The number of nodes on the path.
+ */
+static int trace_path(const path_search *ps, int dst, int *path)
+{
+	int n = 0;
+	for (int v = dst; v >= 0; v = ps->parent[v]) {
+		n++;
+	}
+	if (path != NULL) {
+		int i = n;
+		for (int v = dst; v >= 0; v = ps->parent[v]) {
+			path[--i] = v;
+		}
+	}
+	return n;
+}
+
+/**
+ * heap_place() - Put a node at a position in the heap.
+ * @ps: Search state to use.
+ * @i: Position in the heap.
+ * @v: Id of the node.
+ *
+ * Returns: Nothing.
+ */
+static void heap_place(path_search *ps, int i, int v)
+{
+	ps->queue[i] = v;
+	ps->heap_pos[v] = i;
+}
+
+/**
+ * sift_up() - Move a node up the heap until its parent is not larger.
+ * @ps: Search state to use.
+ * @i: Position of the node in the heap.
+ *
+ * Returns: Nothing.
+ */
+static void sift_up(path_search *ps, int i)
+{
+	int v = ps->queue[i];
+	double d = ps->dist[v];
+	while (i > 0) {
+		int p = (i - 1) / HEAP_ARITY;
+		int u = ps->queue[p];
+		if (ps->dist[u] <= d) {
+			break;
+		}
+		heap_place(ps, i, u);
+		i = p;
+	}
+	heap_place(ps, i, v);
+}
+
+/**
+ * sift_down() - Move a node down the heap until no child is smaller.
+ * @ps: Search state to use.
+ * @i: Position of the node in the heap.
+ *
+ * Returns: Nothing.
+ */
+static void sift_down(path_search *ps, int i)
+{
+	int v = ps->queue[i];
+	double d = ps->dist[v];
+	while (true) {
+		int first = HEAP_ARITY * i + 1;
+		if (first >= ps->heap_size) {
+			break;
+		}
+		int end = first + HEAP_ARITY;
+		if (end > ps->heap_size) {
+			end = ps->heap_size;
+		}
+		// Find the smallest child.
+		int best = first;
+		double best_dist = ps->dist[ps->queue[first]];
+		for (int j = first + 1; j < end; j++) {
+			if (ps->dist[ps->queue[j]] < best_dist) {
+				best = j;
+				best_dist = ps->dist[ps->queue[j]];
+			}
+		}
+		int u = ps->queue[best];
+		if (best_dist >= d) {
+			break;
+		}
+		heap_place(ps, i, u);
+		i = best;
+	}
+	heap_place(ps, i, v);
+}
+
+/**
+ * heap_pop() - Remove the node with the smallest distance from the heap.
+ * @ps: Search state with a non-empty heap.
+ *
+ * Returns: The id of the removed node.
+ */
+static int heap_pop(path_search *ps)
+{
+	int v = ps->queue[0];
+	ps->heap_pos[v] = -1;
+	ps->heap_size--;
+	if (ps->heap_size > 0) {
+		heap_place(ps, 0, ps->queue[ps->heap_size]);
+		sift_down(ps, 0);
+	}
+	return v;
+}
+
+/**
+ * heap_push() - Insert a reached node into the heap.
+ * @ps: Search state to use.
+ * @v: Id of the node.
+ *
+ * Returns: Nothing.
+ */
+static void heap_push(path_search *ps, int v)
+{
+	heap_place(ps, ps->heap_size, v);
+	ps->heap_size++;
+	sift_up(ps, ps->heap_size - 1);
+}
+
+// =================== SHORTEST PATH INTERFACE ======================
+
+/**
+ * path_search_new() - Create the search state for a graph.
+ * @g: Frozen graph to search.
+ *
+ * Returns: A pointer to the new search state.
+ */
+path_search *path_search_new(const graph *g)
+{
+	path_search *ps = malloc(sizeof(path_search));
+	int n = graph_nr_of_nodes(g);
+	int size = n > 0 ? n : 1;
+	ps->c = graph_csr(g);
+	ps->nr_of_nodes = n;
+	ps->epoch = 0;
+	ps->stamps = calloc(size, sizeof(unsigned int));
+	ps->parent = malloc(size * sizeof(int));
+	ps->dist = malloc(size * sizeof(double));
+	ps->queue = malloc(size * sizeof(int));
+	ps->heap_pos = malloc(size * sizeof(int));
+	ps->heap_size = 0;
+
+	return ps;
+}
+
+/**
+ * graph_shortest_path() - Find a path with the fewest edges.
+ * @ps: Search state for the graph.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @path: Array where the ids of the nodes on the path are stored, or NULL.
+ *
+ * Breadth-first search from src that stops as soon as dst is reached.
+ *
+ * Returns: The number of edges on the path, or -1 if there is no path.
+ */
+int graph_shortest_path(path_search *ps, int src, int dst, int *path)
+{
+	const csr *c = ps->c;
+	int head = 0;
+	int tail = 0;
+
+	start_search(ps);
+	reach(ps, src, -1, 0);
+	ps->queue[tail++] = src;
+	while (head < tail && !is_reached(ps, dst)) {
+		int v = ps->queue[head++];
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			if (!is_reached(ps, w)) {
+				reach(ps, w, v, ps->dist[v] + 1);
+				ps->queue[tail++] = w;
+			}
+		}
+	}
+	if (!is_reached(ps, dst)) {
+		return -1;
+	}
+	return trace_path(ps, dst, path) - 1;
+}
+
+/**
+ * graph_weighted_shortest_path() - Find a path with the smallest total
+ * 				    weight.
+ * @ps: Search state for the graph.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @path: Array where the ids of the nodes on the path are stored, or NULL.
+ * @nr_in_path: Pointer to where the number of nodes on the path is stored,
+ * 		or NULL.
+ *
+ * Dijkstra's algorithm from src that stops as soon as dst leaves the heap,
+ * since its distance is final then.
+ *
+ * Returns: The total weight of the path, or -1 if there is no path.
+ */
+double graph_weighted_shortest_path(path_search *ps, int src, int dst,
+				    int *path, int *nr_in_path)
+{
+	const csr *c = ps->c;
+	bool found = false;
+
+	start_search(ps);
+	ps->heap_size = 0;
+	reach(ps, src, -1, 0);
+	heap_push(ps, src);
+	while (ps->heap_size > 0) {
+		int v = heap_pop(ps);
+		if (v == dst) {
+			found = true;
+			break;
+		}
+		for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+			int w = c->targets[e];
+			double d = ps->dist[v]
+				+ (c->weights != NULL ? c->weights[e] : 1.0);
+			if (!is_reached(ps, w)) {
+				reach(ps, w, v, d);
+				heap_push(ps, w);
+			} else if (ps->heap_pos[w] >= 0 && d < ps->dist[w]) {
+				// Shorter path to a node still in the heap.
+				ps->dist[w] = d;
+				ps->parent[w] = v;
+				sift_up(ps, ps->heap_pos[w]);
+			}
+		}
+	}
+	if (!found) {
+		if (nr_in_path != NULL) {
+			*nr_in_path = 0;
+		}
+		return -1;
+	}
+	int n = trace_path(ps, dst, path);
+	if (nr_in_path != NULL) {
+		*nr_in_path = n;
+	}
+	return ps->dist[dst];
+}
+
+/**
+ * path_search_kill() - Destroy the search state.
+ * @ps: Search state to destroy.
+ *
+ * Returns: Nothing.
+ */
+void path_search_kill(path_search *ps)
+{
+	free(ps->stamps);
+	free(ps->parent);
+	free(ps->dist);
+	free(ps->queue);
+	free(ps->heap_pos);
+	free(ps);
+}
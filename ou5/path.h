@@ -0,0 +1,82 @@
+#ifndef __PATH_H
+#define __PATH_H
+
+#include "graph.h"
+
+/*
+ * Shortest paths in a frozen graph for OU5, see graph_freeze(). Two kinds of
+ * questions are answered:
+ *
+ *   - The path with the fewest edges, found by a breadth-first search that
+ *     records the parent of each reached node.
+ *   - The path with the smallest sum of edge weights, found by Dijkstra's
+ *     algorithm with a 4-ary heap. Edges without weights count as 1. All
+ *     weights must be non-negative.
+ *
+ * All state of a search is kept in a path_search object, in flat arrays
+ * indexed by node id: distances, parents, heap positions and the queue.
+ * The arrays are allocated once and stamped with the number of the search,
+ * so a new search does not have to clear them. After use, the function
+ * path_search_kill() must be called to de-allocate the dynamic memory used
+ * by the object.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct path_search path_search;
+
+// =================== SHORTEST PATH INTERFACE ======================
+
+/**
+ * path_search_new() - Create the search state for a graph.
+ * @g: Frozen graph to search, see graph_freeze(). The graph must not be
+ *     modified while the object is in use.
+ *
+ * Returns: A pointer to the new search state.
+ */
+path_search *path_search_new(const graph *g);
+
+/**
+ * graph_shortest_path() - Find a path with the fewest edges.
+ * @ps: Search state for the graph.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @path: Array of at least nr_of_nodes elements, where the ids of the nodes
+ * 	  on the path are stored, from src to dst. May be NULL.
+ *
+ * Returns: The number of edges on the path (the hop count), or -1 if there
+ * 	    is no path from src to dst.
+ */
+int graph_shortest_path(path_search *ps, int src, int dst, int *path);
+
+/**
+ * graph_weighted_shortest_path() - Find a path with the smallest total
+ * 				    weight.
+ * @ps: Search state for the graph.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @path: Array of at least nr_of_nodes elements, where the ids of the nodes
+ * 	  on the path are stored, from src to dst. May be NULL.
+ * @nr_in_path: Pointer to where the number of nodes on the path is stored,
+ * 		0 if there is no path. May be NULL.
+ *
+ * Returns: The total weight of the path, or -1 if there is no path from src
+ * 	    to dst.
+ */
+double graph_weighted_shortest_path(path_search *ps, int src, int dst,
+				    int *path, int *nr_in_path);
+
+/**
+ * path_search_kill() - Destroy the search state.
+ * @ps: Search state to destroy.
+ *
+ * Returns: Nothing.
+ */
+void path_search_kill(path_search *ps);
+
+#endif
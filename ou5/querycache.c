@@ -0,0 +1,320 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "querycache.h"
+#include "hashtable.h"
+
+/*
+ * Implementation of the cache of answers to reachability questions for OU5,
+ * see querycache.h. The single answers are stored in a fixed array of
+ * entries, linked together in a doubly linked list in order of use. A hash
+ * table from OU4 maps each (source, destination) key to its entry. The
+ * reachable sets are stored as bitsets, one bit per node id.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+struct pair_entry {
+	uint64_t key;	// Source id in the high bits, destination id low.
+	bool answer;
+	int prev;	// More recently used entry, or -1.
+	int next;	// Less recently used entry, or -1.
+};
+
+struct source_set {
+	int src;	// Source id, or -1 for an unused set.
+	uint64_t *bits;
+	unsigned long last_used;
+};
+
+struct query_cache {
+	const graph *g;
+	unsigned long version;
+	table *index;
+	struct pair_entry *pairs;
+	int max_pairs;
+	int nr_of_pairs;
+	int first;	// Most recently used entry, or -1.
+	int last;	// Least recently used entry, or -1.
+	struct source_set *sets;
+	int max_sources;
+	int words;	// Number of words in each bitset.
+	unsigned long clock;
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * compare_keys() - Compare two pair keys.
+ * @k1: Pointer to key 1.
+ * @k2: Pointer to key 2.
+ *
+ * Compare function for the pair index, see util.h.
+ *
+ * Returns: Negative, zero or positive value if k1 is smaller than, equal to
+ * 	    or larger than k2.
+ */
+static int compare_keys(const void *k1, const void *k2)
+{
+	uint64_t a = *(const uint64_t *)k1;
+	uint64_t b = *(const uint64_t *)k2;
+	return (a > b) - (a < b);
+}
+
+/**
+ * make_key() - Combine a source and a destination id into one key.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ *
+ * Returns: The key of the pair.
+ */
+static uint64_t make_key(int src, int dst)
+{
+	return ((uint64_t)(uint32_t)src << 32) | (uint32_t)dst;
+}
+
+/**
+ * unlink_entry() - Remove an entry from the list in order of use.
+ * @qc: Cache to manipulate.
+ * @i: Index of the entry.
+ *
+ * Returns: Nothing.
+ */
+static void unlink_entry(query_cache *qc, int i)
+{
+	struct pair_entry *e = &qc->pairs[i];
+	if (e->prev >= 0) {
+		qc->pairs[e->prev].next = e->next;
+	} else {
+		qc->first = e->next;
+	}
+	if (e->next >= 0) {
+		qc->pairs[e->next].prev = e->prev;
+	} else {
+		qc->last = e->prev;
+	}
+}
+
+/**
+ * push_entry() - Insert an entry first in the list in order of use.
+ * @qc: Cache to manipulate.
+ * @i: Index of the entry.
+ *
+ * Returns: Nothing.
+ */
+static void push_entry(query_cache *qc, int i)
+{
+	struct pair_entry *e = &qc->pairs[i];
+	e->prev = -1;
+	e->next = qc->first;
+	if (qc->first >= 0) {
+		qc->pairs[qc->first].prev = i;
+	} else {
+		qc->last = i;
+	}
+	qc->first = i;
+}
+
+/**
+ * clear() - Drop all entries of a cache.
+ * @qc: Cache to manipulate.
+ *
+ * Returns: Nothing.
+ */
+static void clear(query_cache *qc)
+{
+	table_kill(qc->index);
+	qc->index = table_empty_hash(compare_keys, hash_u64, NULL, NULL);
+	qc->nr_of_pairs = 0;
+	qc->first = -1;
+	qc->last = -1;
+	for (int i = 0; i < qc->max_sources; i++) {
+		free(qc->sets[i].bits);
+		qc->sets[i].bits = NULL;
+		qc->sets[i].src = -1;
+	}
+}
+
+/**
+ * check_version() - Drop all entries if the graph has been modified.
+ * @qc: Cache to manipulate.
+ *
+ * Returns: Nothing.
+ */
+static void check_version(query_cache *qc)
+{
+	unsigned long version = graph_version(qc->g);
+	if (version != qc->version) {
+		clear(qc);
+		qc->version = version;
+		qc->words = (graph_nr_of_nodes(qc->g) + 63) / 64;
+	}
+}
+
+// =================== QUERY CACHE INTERFACE ======================
+
+/**
+ * query_cache_new() - Create an empty cache.
+ * @g: Graph that the questions are about.
+ * @max_pairs: Maximum number of single answers to keep, at least 1.
+ * @max_sources: Maximum number of reachable sets to keep, at least 1.
+ *
+ * Returns: A pointer to the new cache.
+ */
+query_cache *query_cache_new(const graph *g, int max_pairs, int max_sources)
+{
+	query_cache *qc = calloc(1, sizeof(query_cache));
+	qc->g = g;
+	qc->version = graph_version(g);
+	qc->index = table_empty_hash(compare_keys, hash_u64, NULL, NULL);
+	qc->pairs = malloc(max_pairs * sizeof(struct pair_entry));
+	qc->max_pairs = max_pairs;
+	qc->nr_of_pairs = 0;
+	qc->first = -1;
+	qc->last = -1;
+	qc->sets = calloc(max_sources, sizeof(struct source_set));
+	qc->max_sources = max_sources;
+	for (int i = 0; i < max_sources; i++) {
+		qc->sets[i].src = -1;
+	}
+	qc->words = (graph_nr_of_nodes(g) + 63) / 64;
+	qc->clock = 0;
+
+	return qc;
+}
+
+/**
+ * query_cache_lookup() - Look up the answer to a question.
+ * @qc: Cache to use.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @answer: Pointer to where the answer is stored, if it is found.
+ *
+ * Returns: True if the answer was found in the cache, false otherwise.
+ */
+bool query_cache_lookup(query_cache *qc, int src, int dst, bool *answer)
+{
+	check_version(qc);
+
+	// Single answers first.
+	uint64_t key = make_key(src, dst);
+	struct pair_entry *e = table_lookup(qc->index, &key);
+	if (e != NULL) {
+		// Move the entry first in order of use.
+		int i = e - qc->pairs;
+		unlink_entry(qc, i);
+		push_entry(qc, i);
+		*answer = e->answer;
+		return true;
+	}
+	// Then the reachable sets.
+	for (int i = 0; i < qc->max_sources; i++) {
+		struct source_set *set = &qc->sets[i];
+		if (set->src == src) {
+			set->last_used = ++qc->clock;
+			*answer = (set->bits[dst / 64] >> (dst % 64)) & 1;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * query_cache_store() - Store the answer to a question.
+ * @qc: Cache to manipulate.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @answer: True if there is a path from src to dst.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_store(query_cache *qc, int src, int dst, bool answer)
+{
+	check_version(qc);
+
+	uint64_t key = make_key(src, dst);
+	struct pair_entry *e = table_lookup(qc->index, &key);
+	int i;
+	if (e != NULL) {
+		i = e - qc->pairs;
+		unlink_entry(qc, i);
+	} else {
+		if (qc->nr_of_pairs < qc->max_pairs) {
+			i = qc->nr_of_pairs++;
+		} else {
+			// Reuse the least recently used entry.
+			i = qc->last;
+			unlink_entry(qc, i);
+			table_remove(qc->index, &qc->pairs[i].key);
+		}
+		// The index refers to the key inside the entry.
+		qc->pairs[i].key = key;
+		table_insert(qc->index, &qc->pairs[i].key, &qc->pairs[i]);
+	}
+	qc->pairs[i].answer = answer;
+	push_entry(qc, i);
+}
+
+/**
+ * query_cache_store_reachable() - Store the set of nodes reachable from a
+ * 				   node.
+ * @qc: Cache to manipulate.
+ * @src: Id of the source node.
+ * @reached: Array with the ids of all nodes reachable from src.
+ * @nr_reached: Number of ids in reached.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_store_reachable(query_cache *qc, int src, const int *reached,
+				 int nr_reached)
+{
+	check_version(qc);
+
+	// Replace the set of the same source, an unused set, or the least
+	// recently used set, in that order.
+	struct source_set *set = &qc->sets[0];
+	for (int i = 0; i < qc->max_sources; i++) {
+		struct source_set *s = &qc->sets[i];
+		if (s->src == src) {
+			set = s;
+			break;
+		}
+		if (set->src >= 0 && (s->src < 0
+				      || s->last_used < set->last_used)) {
+			set = s;
+		}
+	}
+	if (set->bits == NULL) {
+		set->bits = malloc((qc->words > 0 ? qc->words : 1)
+				   * sizeof(uint64_t));
+	}
+	memset(set->bits, 0, qc->words * sizeof(uint64_t));
+	for (int i = 0; i < nr_reached; i++) {
+		set->bits[reached[i] / 64] |= (uint64_t)1 << (reached[i] % 64);
+	}
+	set->src = src;
+	set->last_used = ++qc->clock;
+}
+
+/**
+ * query_cache_kill() - Destroy a cache.
+ * @qc: Cache to destroy.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_kill(query_cache *qc)
+{
+	table_kill(qc->index);
+	free(qc->pairs);
+	for (int i = 0; i < qc->max_sources; i++) {
+		free(qc->sets[i].bits);
+	}
+	free(qc->sets);
+	free(qc);
+}
@@ -0,0 +1,90 @@
+#ifndef __QUERYCACHE_H
+#define __QUERYCACHE_H
+
+#include <stdbool.h>
+#include "graph.h"
+
+/*
+ * Cache of answers to reachability questions for OU5. The cache holds two
+ * kinds of entries:
+ *
+ *   - Answers to single questions, keyed by the (source, destination) pair
+ *     of node ids. At most max_pairs answers are kept, and the least
+ *     recently used answer is evicted first.
+ *   - Complete sets of reachable nodes, as left by a breadth-first search
+ *     that was run to the end. Such a set answers every question from its
+ *     source node. At most max_sources sets are kept, least recently used
+ *     evicted first.
+ *
+ * The cache remembers the version of the graph it was filled from, see
+ * graph_version(). As soon as the graph has been modified, all entries are
+ * dropped. After use, the function query_cache_kill() must be called to
+ * de-allocate the dynamic memory used by the cache.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct query_cache query_cache;
+
+// =================== QUERY CACHE INTERFACE ======================
+
+/**
+ * query_cache_new() - Create an empty cache.
+ * @g: Graph that the questions are about.
+ * @max_pairs: Maximum number of single answers to keep, at least 1.
+ * @max_sources: Maximum number of reachable sets to keep, at least 1.
+ *
+ * Returns: A pointer to the new cache.
+ */
+query_cache *query_cache_new(const graph *g, int max_pairs, int max_sources);
+
+/**
+ * query_cache_lookup() - Look up the answer to a question.
+ * @qc: Cache to use.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @answer: Pointer to where the answer is stored, if it is found.
+ *
+ * Returns: True if the answer was found in the cache, false otherwise.
+ */
+bool query_cache_lookup(query_cache *qc, int src, int dst, bool *answer);
+
+/**
+ * query_cache_store() - Store the answer to a question.
+ * @qc: Cache to manipulate.
+ * @src: Id of the source node.
+ * @dst: Id of the destination node.
+ * @answer: True if there is a path from src to dst.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_store(query_cache *qc, int src, int dst, bool answer);
+
+/**
+ * query_cache_store_reachable() - Store the set of nodes reachable from a
+ * 				   node.
+ * @qc: Cache to manipulate.
+ * @src: Id of the source node.
+ * @reached: Array with the ids of all nodes reachable from src, including
+ * 	     src itself, e.g. the queue of a completed breadth-first search.
+ * @nr_reached: Number of ids in reached.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_store_reachable(query_cache *qc, int src, const int *reached,
+				 int nr_reached);
+
+/**
+ * query_cache_kill() - Destroy a cache.
+ * @qc: Cache to destroy.
+ *
+ * Returns: Nothing.
+ */
+void query_cache_kill(query_cache *qc);
+
+#endif
@@ -0,0 +1,393 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "scc.h"
+
+/*
+ * Implementation of the SCC based reachability index for OU5, see scc.h.
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Search state moved to scc_scratch objects.
+ */
+
+// ==================== INTERNAL CONSTANTS ===========================
+
+// Largest condensation for which the transitive closure is stored. The
+// closure takes MAX_CLOSURE^2/8 bytes.
+#define MAX_CLOSURE 8192
+
+// ====================== INTERNAL DATA TYPES ==========================
+
+struct scc_index {
+	int nr_of_nodes;
+	int nr_of_components;
+	int *component;		// Component number of each node.
+	csr *dag;		// Condensation, edges between components.
+	uint64_t *closure;	// Reachable components, or NULL.
+	int words;		// Number of words in each closure row.
+	scc_scratch *scratch;	// Used by scc_index_reachable().
+};
+
+struct scc_scratch {
+	unsigned int *stamps;	// Seen status for searches in the dag.
+	unsigned int epoch;
+	int *queue;
+	int size;
+};
+
+// ===================== INTERNAL FUNCTIONS ==========================
+
+/**
+ * find_components() - Find the strongly connected components of a graph.
+ * @c: CSR structure with the edges of the graph.
+ * @component: Array where the component number of each node is stored.
+ *
+ * Iterative version of Tarjan's algorithm. The recursion of the depth-first
+ * search is replaced by an explicit stack of nodes, where the position of
+ * each node in its edge list is kept in next_edge. Components are numbered
+ * in the order they are completed, which is a reverse topological order.
+ *
+ * Returns: The number of components.
+ */
+static int find_components(const csr *c, int *component)
+{
+	int n = c->nr_of_nodes;
+	int *index = malloc(n * sizeof(int));
+	int *lowlink = malloc(n * sizeof(int));
+	int *next_edge = malloc(n * sizeof(int));
+	int *call_stack = malloc(n * sizeof(int));
+	int *scc_stack = malloc(n * sizeof(int));
+	bool *on_stack = calloc(n, sizeof(bool));
+	int call_top = 0;
+	int scc_top = 0;
+	int counter = 0;
+	int nr_of_components = 0;
+
+	for (int v = 0; v < n; v++) {
+		index[v] = -1;
+	}
+	for (int root = 0; root < n; root++) {
+		if (index[root] >= 0) {
+			continue;
+		}
+		// Visit the root.
+		index[root] = lowlink[root] = counter++;
+		next_edge[root] = c->offsets[root];
+		call_stack[call_top++] = root;
+		scc_stack[scc_top++] = root;
+		on_stack[root] = true;
+
+		while (call_top > 0) {
+			int v = call_stack[call_top - 1];
+			if (next_edge[v] < c->offsets[v + 1]) {
+				int w = c->targets[next_edge[v]++];
+				if (index[w] < 0) {
+					// Descend into w.
+					index[w] = lowlink[w] = counter++;
+					next_edge[w] = c->offsets[w];
+					call_stack[call_top++] = w;
+					scc_stack[scc_top++] = w;
+					on_stack[w] = true;
+				} else if (on_stack[w] && index[w] < lowlink[v]) {
+					lowlink[v] = index[w];
+				}
+				continue;
+			}
+			// All edges of v done, return to the caller.
+			call_top--;
+			if (call_top > 0) {
+				int u = call_stack[call_top - 1];
+				if (lowlink[v] < lowlink[u]) {
+					lowlink[u] = lowlink[v];
+				}
+			}
+			if (lowlink[v] == index[v]) {
+				// v is the root of a component, pop it.
+				int w;
+				do {
+					w = scc_stack[--scc_top];
+					on_stack[w] = false;
+					component[w] = nr_of_components;
+				} while (w != v);
+				nr_of_components++;
+			}
+		}
+	}
+	free(index);
+	free(lowlink);
+	free(next_edge);
+	free(call_stack);
+	free(scc_stack);
+	free(on_stack);
+
+	return nr_of_components;
+}
+
+/**
+ * build_dag() - Build the condensation of a graph.
+ * @c: CSR structure with the edges of the graph.
+ * @component: Component number of each node.
+ * @k: Number of components.
+ *
+ * Each edge between two different components is kept once.
+ *
+ * Returns: A CSR structure with the edges between the components.
+ */
+static csr *build_dag(const csr *c, const int *component, int k)
+{
+	int n = c->nr_of_nodes;
+	// Group the nodes by component.
+	int *ids = malloc((n > 0 ? n : 1) * sizeof(int));
+	for (int v = 0; v < n; v++) {
+		ids[v] = v;
+	}
+	csr *members = csr_build(k, n, component, ids);
+	free(ids);
+
+	int *src = malloc((c->nr_of_edges > 0 ? c->nr_of_edges : 1)
+			  * sizeof(int));
+	int *dst = malloc((c->nr_of_edges > 0 ? c->nr_of_edges : 1)
+			  * sizeof(int));
+	// last[d] == s if the edge s -> d has already been added.
+	int *last = malloc((k > 0 ? k : 1) * sizeof(int));
+	for (int d = 0; d < k; d++) {
+		last[d] = -1;
+	}
+	int m = 0;
+	for (int s = 0; s < k; s++) {
+		for (int i = members->offsets[s]; i < members->offsets[s + 1];
+		     i++) {
+			int v = members->targets[i];
+			for (int e = c->offsets[v]; e < c->offsets[v + 1]; e++) {
+				int d = component[c->targets[e]];
+				if (d != s && last[d] != s) {
+					last[d] = s;
+					src[m] = s;
+					dst[m] = d;
+					m++;
+				}
+			}
+		}
+	}
+	csr *dag = csr_build(k, m, src, dst);
+	free(src);
+	free(dst);
+	free(last);
+	csr_kill(members);
+
+	return dag;
+}
+
+/**
+ * build_closure() - Build the transitive closure of the condensation.
+ * @x: Index to manipulate.
+ *
+ * Every edge of the condensation goes from a higher to a lower component
+ * number, so the rows can be filled in increasing order: the row of a
+ * component is its own bit combined with the rows of its successors.
+ *
+ * Returns: Nothing.
+ */
+static void build_closure(scc_index *x)
+{
+	int k = x->nr_of_components;
+	x->words = (k + 63) / 64;
+	x->closure = calloc((size_t)k * x->words, sizeof(uint64_t));
+	for (int s = 0; s < k; s++) {
+		uint64_t *row = &x->closure[(size_t)s * x->words];
+		row[s / 64] |= (uint64_t)1 << (s % 64);
+		for (int e = x->dag->offsets[s]; e < x->dag->offsets[s + 1];
+		     e++) {
+			const uint64_t *succ =
+				&x->closure[(size_t)x->dag->targets[e] * x->words];
+			for (int i = 0; i < x->words; i++) {
+				row[i] |= succ[i];
+			}
+		}
+	}
+}
+
+/**
+ * search_dag() - Search the condensation for a path between components.
+ * @x: Index to use.
+ * @scratch: Search state to use.
+ * @s: Source component.
+ * @d: Destination component.
+ *
+ * Breadth-first search that skips all components numbered lower than d,
+ * since no path from them can lead to d.
+ *
+ * Returns: True if there is a path from s to d.
+ */
+static bool search_dag(const scc_index *x, scc_scratch *scratch, int s,
+		       int d)
+{
+	scratch->epoch++;
+	if (scratch->epoch == 0) {
+		// Counter wrapped, old stamps could match new epochs.
+		memset(scratch->stamps, 0,
+		       scratch->size * sizeof(unsigned int));
+		scratch->epoch = 1;
+	}
+	int head = 0;
+	int tail = 0;
+	scratch->stamps[s] = scratch->epoch;
+	scratch->queue[tail++] = s;
+	while (head < tail) {
+		int v = scratch->queue[head++];
+		for (int e = x->dag->offsets[v]; e < x->dag->offsets[v + 1];
+		     e++) {
+			int w = x->dag->targets[e];
+			if (w == d) {
+				return true;
+			}
+			if (w > d && scratch->stamps[w] != scratch->epoch) {
+				scratch->stamps[w] = scratch->epoch;
+				scratch->queue[tail++] = w;
+			}
+		}
+	}
+	return false;
+}
+
+// =================== SCC INDEX INTERFACE ======================
+
+/**
+ * scc_index_build() - Build the reachability index of a graph.
+ * @c: CSR structure with the edges of the graph, see csr.h.
+ *
+ * Returns: A pointer to the new index.
+ */
+scc_index *scc_index_build(const csr *c)
+{
+	scc_index *x = calloc(1, sizeof(scc_index));
+	x->nr_of_nodes = c->nr_of_nodes;
+	x->component = malloc((c->nr_of_nodes > 0 ? c->nr_of_nodes : 1)
+			      * sizeof(int));
+	x->nr_of_components = find_components(c, x->component);
+	x->dag = build_dag(c, x->component, x->nr_of_components);
+
+	if (x->nr_of_components <= MAX_CLOSURE) {
+		build_closure(x);
+	} else {
+		x->closure = NULL;
+	}
+	x->scratch = scc_scratch_new(x);
+	return x;
+}
+
+/**
+ * scc_index_nr_of_components() - Return the number of components.
+ * @x: Index to inspect.
+ *
+ * Returns: The number of strongly connected components of the graph.
+ */
+int scc_index_nr_of_components(const scc_index *x)
+{
+	return x->nr_of_components;
+}
+
+/**
+ * scc_index_component() - Return the component of a node.
+ * @x: Index to inspect.
+ * @v: Node number.
+ *
+ * Returns: The component number of node v.
+ */
+int scc_index_component(const scc_index *x, int v)
+{
+	return x->component[v];
+}
+
+/**
+ * scc_scratch_new() - Create search state for an index.
+ * @x: Index that the search state is for.
+ *
+ * Returns: A pointer to the new search state.
+ */
+scc_scratch *scc_scratch_new(const scc_index *x)
+{
+	scc_scratch *scratch = malloc(sizeof(scc_scratch));
+	scratch->size = x->closure == NULL ? x->nr_of_components : 0;
+	scratch->epoch = 0;
+	scratch->stamps = calloc(scratch->size > 0 ? scratch->size : 1,
+				 sizeof(unsigned int));
+	scratch->queue = malloc((scratch->size > 0 ? scratch->size : 1)
+				* sizeof(int));
+	return scratch;
+}
+
+/**
+ * scc_scratch_kill() - Destroy search state.
+ * @scratch: Search state to destroy.
+ *
+ * Returns: Nothing.
+ */
+void scc_scratch_kill(scc_scratch *scratch)
+{
+	free(scratch->stamps);
+	free(scratch->queue);
+	free(scratch);
+}
+
+/**
+ * scc_index_reachable() - Check if there is a path between two nodes.
+ * @x: Index to use.
+ * @src: Source node number.
+ * @dst: Destination node number.
+ *
+ * Returns: True if there is a path from src to dst.
+ */
+bool scc_index_reachable(scc_index *x, int src, int dst)
+{
+	return scc_index_reachable_r(x, x->scratch, src, dst);
+}
+
+/**
+ * scc_index_reachable_r() - Check if there is a path between two nodes,
+ * 			     with given search state.
+ * @x: Index to use.
+ * @scratch: Search state to use.
+ * @src: Source node number.
+ * @dst: Destination node number.
+ *
+ * Returns: True if there is a path from src to dst.
+ */
+bool scc_index_reachable_r(const scc_index *x, scc_scratch *scratch, int src,
+			   int dst)
+{
+	int s = x->component[src];
+	int d = x->component[dst];
+	if (s == d) {
+		// Same component, always a path.
+		return true;
+	}
+	if (s < d) {
+		// Paths only lead to lower component numbers.
+		return false;
+	}
+	if (x->closure != NULL) {
+		const uint64_t *row = &x->closure[(size_t)s * x->words];
+		return (row[d / 64] >> (d % 64)) & 1;
+	}
+	return search_dag(x, scratch, s, d);
+}
+
+/**
+ * scc_index_kill() - Destroy a reachability index.
+ * @x: Index to destroy.
+ *
+ * Returns: Nothing.
+ */
+void scc_index_kill(scc_index *x)
+{
+	free(x->component);
+	csr_kill(x->dag);
+	free(x->closure);
+	scc_scratch_kill(x->scratch);
+	free(x);
+}
@@ -0,0 +1,122 @@
+#ifndef __SCC_H
+#define __SCC_H
+
+#include <stdbool.h>
+#include "csr.h"
+
+/*
+ * Reachability index for OU5, based on the strongly connected components
+ * (SCCs) of a directed graph. The components are found with an iterative
+ * version of Tarjan's algorithm and contracted to single nodes, which gives
+ * a directed acyclic graph (the condensation). Two nodes in the same
+ * component always reach each other. For small condensations the full
+ * transitive closure is stored as one bitset per component, which answers
+ * every question in constant time. Larger condensations are searched
+ * breadth-first, which only visits the components and not the nodes of the
+ * original graph. After use, the function scc_index_kill() must be called to
+ * de-allocate the dynamic memory used by the index.
+ *
+ * The index is not modified by questions. Each thread that asks questions
+ * at the same time as other threads needs its own search state, see
+ * scc_scratch_new() and scc_index_reachable_r().
+ *
+ * Author: Elias Olofsson (tfy17eon@cs.umu.se)
+ *
+ * Version information:
+ *   v1.0  2026-10-17: First public version.
+ *   v1.1  2026-10-17: Added scc_scratch and scc_index_reachable_r().
+ */
+
+// ====================== PUBLIC DATA TYPES ==========================
+
+typedef struct scc_index scc_index;
+
+// Search state for questions to an index.
+typedef struct scc_scratch scc_scratch;
+
+// =================== SCC INDEX INTERFACE ======================
+
+/**
+ * scc_index_build() - Build the reachability index of a graph.
+ * @c: CSR structure with the edges of the graph, see csr.h.
+ *
+ * Takes O(N + E) time for a graph with N nodes and E edges, plus the time to
+ * build the transitive closure if the condensation is small.
+ *
+ * Returns: A pointer to the new index.
+ */
+scc_index *scc_index_build(const csr *c);
+
+/**
+ * scc_index_nr_of_components() - Return the number of components.
+ * @x: Index to inspect.
+ *
+ * Returns: The number of strongly connected components of the graph.
+ */
+int scc_index_nr_of_components(const scc_index *x);
+
+/**
+ * scc_index_component() - Return the component of a node.
+ * @x: Index to inspect.
+ * @v: Node number.
+ *
+ * The components are numbered in reverse topological order, i.e. if there is
+ * a path from node u to node v, the component of u is not smaller than the
+ * component of v.
+ *
+ * Returns: The component number of node v.
+ */
+int scc_index_component(const scc_index *x, int v);
+
+/**
+ * scc_index_reachable() - Check if there is a path between two nodes.
+ * @x: Index to use. Uses search state kept in the index, so it must not be
+ *     called by more than one thread at a time.
+ * @src: Source node number.
+ * @dst: Destination node number.
+ *
+ * Returns: True if there is a path from src to dst.
+ */
+bool scc_index_reachable(scc_index *x, int src, int dst);
+
+/**
+ * scc_scratch_new() - Create search state for an index.
+ * @x: Index that the search state is for.
+ *
+ * After use, the function scc_scratch_kill() must be called.
+ *
+ * Returns: A pointer to the new search state.
+ */
+scc_scratch *scc_scratch_new(const scc_index *x);
+
+/**
+ * scc_index_reachable_r() - Check if there is a path between two nodes,
+ * 			     with given search state.
+ * @x: Index to use.
+ * @scratch: Search state to use, not used by any other thread at the same
+ * 	     time.
+ * @src: Source node number.
+ * @dst: Destination node number.
+ *
+ * Returns: True if there is a path from src to dst.
+ */
+bool scc_index_reachable_r(const scc_index *x, scc_scratch *scratch, int src,
+			   int dst);
+
+/**
+ * scc_scratch_kill() - Destroy search state.
+ * @scratch: Search state to destroy.
+ *
+ * Returns: Nothing.
+ */
+void scc_scratch_kill(scc_scratch *scratch);
+
+/**
+ * scc_index_kill() - Destroy a reachability index.
+ * @x: Index to destroy.
+ *
+ * Returns: Nothing.
+ */
+void scc_index_kill(scc_index *x);
+
+#endif